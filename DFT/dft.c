@@ -1,12 +1,19 @@
+#include "dft.h"
+#include "src/csv_data.h"
+#include "src/fft.h"
+#include "src/goertzel.h"
+#include "src/welch.h"
+#include "src/window.h"
+#include "src/outofcore.h"
+#include "src/correlate.h"
+#include "src/hilbert.h"
+#include "src/measure.h"
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <regex.h>
 #include <math.h>
-#include <complex.h>
-
-#define BUFFER_SIZE 32
-#define ASCII_TO_INT(x) (x - 48)
-#define IS_ASCII_INT(x) (x >= 48 && x <= 57)
 
 // Pattern for decimal numbers: "-\\?[0-9 ]*[.,][0-9 ]*"
 int regex_test(char *pattern, char *string)
@@ -37,138 +44,675 @@ double complex nth_root (const int n, const int N)
     return cos(angle) - sin(angle) * I;
 }
 
-// Naiive implementation
+/* Transforms use the FFT for any N, with the usual sign convention of exp(-2 pi i n k / N) forward
+ * and exp(+2 pi i n k / N) inverse. The naive sums previously used here had the two directions
+ * swapped, so for a real capture the Imaginary column of DFT.csv is now the negative of what
+ * earlier versions wrote. It matches the outofcore command's DFT.csv. inverse DFT.csv is
+ * unchanged. */
 void DFT (const double complex *time, double complex *freq, const int N)
-{	
-    for (int k = 0; k < N; k++)
+{
+    struct FftPlan *plan = fft_plan(N);
+    if (plan == NULL)
+    {
+	printf("ERROR :: Failed to allocate memory\n");
+	return;
+    }
+    fft_forward(plan, time, freq);
+    fft_free(plan);
+}
+
+void inverse_DFT (double complex *time, const double complex *freq, const int N)
+{
+    struct FftPlan *plan = fft_plan(N);
+    if (plan == NULL)
+    {
+	printf("ERROR :: Failed to allocate memory\n");
+	return;
+    }
+    fft_inverse(plan, freq, time);
+    fft_free(plan);
+}
+
+// Transforms the capture and back again, the original behaviour with no command given.
+int transform_capture (void)
+{
+    int size = 0;
+    double *samples = NULL;
+    double sample_rate = 0.0;
+    double complex *data = NULL;
+    double complex *freq = NULL;
+
+    size = load_capture(DEFAULT_INPUT, &samples, &sample_rate);
+    data = size > 0 ? calloc(size, sizeof(double complex)) : NULL;
+    freq = size > 0 ? calloc(size, sizeof(double complex)) : NULL;
+    
+    if(data == NULL || freq == NULL)
+    {
+	printf("ERROR :: Failed to allocate memory\n");
+	free(samples);
+	free(data);
+	free(freq);
+	return 0;
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+	*(data + i) = *(samples + i);
+    }
+
+    DFT(data, freq, size);
+    write_output("DFT.csv", freq, size, "Frequency (Hz)", sample_rate / size);
+
+    inverse_DFT(data, freq, size);
+    write_output("inverse DFT.csv", data, size, "Time (s)", 1.0 / sample_rate);
+
+    free(samples);
+    free(data);
+    free(freq);
+
+    return 1;
+}
+
+// Loads the first channel of a capture and its sample rate. Returns the sample count, 0 on failure.
+int load_capture (const char *path, double **samples, double *sample_rate)
+{
+    int channels = 0;
+    double sample_period = 0.0;
+    int frames = alloc_csv_channels(path, samples, &channels, &sample_period);
+
+    if (frames == 0 || sample_period <= 0.0)
+    {
+	printf("ERROR :: Failed to read %s\n", path);
+	free(*samples);
+	return 0;
+    }
+    *sample_rate = 1.0 / sample_period;
+    return frames;
+}
+
+/* Reads a comma separated list of frequencies from one argument, so file names that happen to be
+ * numbers are never taken as frequencies. Returns the count, 0 if the list is malformed. */
+int parse_frequencies (const char *list, double *frequencies)
+{
+    int count = 0;
+    const char *start = list;
+    char *end = NULL;
+
+    while (count < MAX_BINS)
     {
-	*(freq + k) = 0.0 + 0.0 * I;
-	for (int n = 0; n < N; n++)
+	*(frequencies + count) = strtod(start, &end);
+	if (end == start || (*end != ',' && *end != '\0'))
+	{
+	    break;
+	}
+	count++;
+	if (*end == '\0')
 	{
-	    *(freq + k) += *(time + n) * nth_root(-n*k, N);
+	    return count;
 	}
+	start = end + 1;
     }
+
+    printf("ERROR :: Expected up to %d comma separated frequencies, got %s\n", MAX_BINS, list);
+    return 0;
 }
 
-void inverse_DFT (double complex *time, const double complex *freq, const int N)
+// Writes amplitudes, 2 |X| / N for a sinusoid filling the block, of each bin against time.
+int write_bins (const char *path, const double complex *bins, long rows, int bin_count, const double *frequencies, double row_period, double block_length)
 {
-    for (int n = 0; n < N; n++)
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+	printf("ERROR :: Failed to open output file for writing\n");
+	return 0;
+    }
+
+    fprintf(fp, "Time (s)");
+    for (int b = 0; b < bin_count; b++)
     {
-	*(time + n) = 0.0 + 0.0 * I;
-	for (int k = 0; k < N; k++)
+	fprintf(fp, ", %g Hz", *(frequencies + b));
+    }
+    fprintf(fp, "\n");
+
+    for (long row = 0; row < rows; row++)
+    {
+	fprintf(fp, "%lf", row * row_period);
+	for (int b = 0; b < bin_count; b++)
 	{
-	    *(time + n) += *(freq + k) * nth_root(n*k, N);
+	    fprintf(fp, ", %lf", 2.0 * cabs(*(bins + row * bin_count + b)) / block_length);
 	}
-	*(time + n) /= N;
+	fprintf(fp, "\n");
     }
+    fclose(fp);
+    return 1;
 }
 
-int alloc_csv_data(const char *filepath, double complex **data)
+/* Writes one value per bin against frequency. Powers are written in dB when decibels is set, with
+ * empty bins floored at -300 dB. */
+int write_spectrum (const char *path, const char *label, const double *values, int bins, double bin_width, int decibels)
 {
-    FILE *fp = fopen(filepath, "r");
-    if(fp == NULL)
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL)
     {
+	printf("ERROR :: Failed to open output file for writing\n");
 	return 0;
     }
-    
-    char buff[BUFFER_SIZE];
-    int size = 0;
-    
-    while(fgets(buff, BUFFER_SIZE, fp))
+
+    fprintf(fp, "Frequency (Hz), %s\n", label);
+    for (int k = 0; k < bins; k++)
+    {
+	double value = decibels ? 10.0 * log10(*(values + k) > 1e-30 ? *(values + k) : 1e-30) : *(values + k);
+	fprintf(fp, "%lf, %lf\n", k * bin_width, value);
+    }
+    fclose(fp);
+    return 1;
+}
+
+// goertzel <block length> <frequency,...> [input] [output]
+int goertzel_command (int argc, char **argv)
+{
+    double frequencies[MAX_BINS];
+    int block_length = atoi(argv[0]);
+    int bin_count = argc > 1 ? parse_frequencies(argv[1], frequencies) : 0;
+    double *samples = NULL;
+    double sample_rate = 0.0;
+    int size = bin_count > 0 ? load_capture(argc > 2 ? argv[2] : DEFAULT_INPUT, &samples, &sample_rate) : 0;
+    struct GoertzelBank *bank = size > 0 ? goertzel_create(frequencies, bin_count, sample_rate, block_length) : NULL;
+    double complex *bins = bank != NULL ? malloc((goertzel_output_limit(bank, size) + 1) * bin_count * sizeof(double complex)) : NULL;
+    int status = 0;
+
+    if (bins != NULL)
     {
-	size++;
+	long blocks = goertzel_process(bank, samples, size, bins);
+	status = write_bins(argc > 3 ? argv[3] : "Goertzel.csv", bins, blocks, bin_count, frequencies, block_length / sample_rate, block_length);
     }
 
-    *data = calloc(size - 1, sizeof(double complex));
-    fseek(fp, 0, 0);
-    size = 0;
-    fgets(buff, BUFFER_SIZE, fp);
+    goertzel_free(bank);
+    free(bins);
+    free(samples);
+    return status;
+}
+
+// sliding <window> <frequency,...> [input] [output]
+int sliding_command (int argc, char **argv)
+{
+    double frequencies[MAX_BINS];
+    int window = atoi(argv[0]);
+    int bin_count = argc > 1 ? parse_frequencies(argv[1], frequencies) : 0;
+    double *samples = NULL;
+    double sample_rate = 0.0;
+    int size = bin_count > 0 ? load_capture(argc > 2 ? argv[2] : DEFAULT_INPUT, &samples, &sample_rate) : 0;
+    struct SlidingDft *sdft = size > 0 ? sliding_dft_create(frequencies, bin_count, sample_rate, window) : NULL;
+    double complex *bins = sdft != NULL ? malloc((long) size * bin_count * sizeof(double complex)) : NULL;
+    int status = 0;
 
-    while (fgets(buff, BUFFER_SIZE, fp))
+    if (bins != NULL)
     {
-	int index = 0;
-	double sign = 1.0f;
-	while (index < BUFFER_SIZE && buff[index] != ' ')
+	for (int b = 0; b < bin_count; b++)
 	{
-	    index++;
+	    *(frequencies + b) = *(sdft->bins + b) * sample_rate / window;
 	}
-	index++;
+	sliding_dft_process(sdft, samples, size, bins);
+	status = write_bins(argc > 3 ? argv[3] : "Sliding DFT.csv", bins, size, bin_count, frequencies, 1.0 / sample_rate, window);
+    }
+
+    sliding_dft_free(sdft);
+    free(bins);
+    free(samples);
+    return status;
+}
+
+// Reads an optional window name, defaulting to Hann. Kaiser takes its beta after a colon.
+int parse_window (int argc, char **argv, int index, int length, const struct Window **window)
+{
+    enum WindowType type = HANN;
+    double beta = KAISER_DEFAULT_BETA;
+    char name[32] = "hann";
+
+    if (argc > index)
+    {
+	sscanf(*(argv + index), "%31[^:]:%lf", name, &beta);
+    }
+    if (!window_parse(name, &type))
+    {
+	printf("ERROR :: Unknown window %s\n", name);
+	return 0;
+    }
+    *window = window_get(type, length, 0, beta);
+    return *window != NULL;
+}
 
-	if (buff[index] == '-')
+// spectrum [window] [input] [output]
+int spectrum_command (int argc, char **argv)
+{
+    double *samples = NULL;
+    double sample_rate = 0.0;
+    int size = load_capture(argc > 1 ? argv[1] : DEFAULT_INPUT, &samples, &sample_rate);
+    const struct Window *window = NULL;
+    struct FftPlan *plan = size > 1 && parse_window(argc, argv, 0, size, &window) ? fft_plan(size) : NULL;
+    double complex *X = plan != NULL ? malloc(size * sizeof(double complex)) : NULL;
+    double *amplitudes = X != NULL ? malloc((size / 2 + 1) * sizeof(double)) : NULL;
+    int status = 0;
+
+    if (amplitudes != NULL)
+    {
+	for (int n = 0; n < size; n++)
 	{
-	    sign = -1.0f;
-	    index++;
+	    *(X + n) = *(samples + n) * *(window->values + n);
 	}
+	fft_forward(plan, X, X);
 
-	double num = 0.0f;
-	while (index < BUFFER_SIZE && IS_ASCII_INT(buff[index]) && buff[index] != '\n')
+	// Scaling by the coherent gain reads a bin-centred tone's amplitude directly.
+	for (int k = 0; k < size / 2 + 1; k++)
 	{
-	    num *= 10.0f;
-	    num += ASCII_TO_INT(buff[index]);
-	    index++;
+	    *(amplitudes + k) = cabs(*(X + k)) * (k > 0 && 2 * k != size ? 2.0 : 1.0) / (size * window->coherent_gain);
 	}
-	index++;
-	double frac = 0.0f;
-	double scale = 1.0f;
-	while (index < BUFFER_SIZE && IS_ASCII_INT(buff[index]) && buff[index] != '\n')
+	printf("Coherent gain %lf, ENBW %lf bins (%lf Hz)\n", window->coherent_gain, window->enbw, window->enbw * sample_rate / size);
+	status = write_spectrum(argc > 2 ? argv[2] : "Spectrum.csv", "Amplitude", amplitudes, size / 2 + 1, sample_rate / size, 0);
+    }
+
+    fft_free(plan);
+    free(X);
+    free(amplitudes);
+    free(samples);
+    return status;
+}
+
+// welch <segment> [input] [output] [threads] [window]
+int welch_command (int argc, char **argv)
+{
+    int segment = atoi(argv[0]);
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+    double *samples = NULL;
+    double sample_rate = 0.0;
+    int size = load_capture(argc > 1 ? argv[1] : DEFAULT_INPUT, &samples, &sample_rate);
+    const struct Window *window = NULL;
+    double *psd = size > 0 && segment > 1 && parse_window(argc, argv, 4, segment, &window) ? malloc(welch_bins(segment) * sizeof(double)) : NULL;
+    int status = 0;
+
+    if (psd != NULL && welch_psd(samples, size, sample_rate, window, segment / 2, threads, psd) == 0)
+    {
+	printf("ERROR :: Segment length must be between 2 and the capture length of %d samples\n", size);
+    }
+    else if (psd != NULL)
+    {
+	status = write_spectrum(argc > 2 ? argv[2] : "Welch PSD.csv", "PSD (dB/Hz)", psd, welch_bins(segment), sample_rate / segment, 1);
+    }
+
+    free(psd);
+    free(samples);
+    return status;
+}
+
+/* Streams the capture into the transform's scratch file one tile at a time, so neither the
+ * capture nor the transform is ever wholly in memory. Returns the frames loaded. */
+long stream_capture (const char *path, struct OutOfCoreFft *fft)
+{
+    long chunk = (long) fft->rows * fft->tile_columns;
+    double *values = malloc(chunk * sizeof(double));
+    FILE *fp = values != NULL ? fopen(path, "r") : NULL;
+    long filled = 0;
+    long count = 0;
+
+    while (fp != NULL && filled < fft->size && (count = read_csv_frames(fp, values, fft->size - filled < chunk ? fft->size - filled : chunk)) > 0)
+    {
+	for (long n = 0; n < count; n++)
 	{
-	    frac *= 10.0f;
-	    scale *= 10.0f;
-	    frac += ASCII_TO_INT(buff[index]);
-	    index++;
+	    *(fft->data + filled + n) = *(values + n);
 	}
-	num += frac / scale;
-	*(*data + size) = sign * num + 0.0 * I;
-	size++;
+	ooc_release(fft, filled, count);
+	filled += count;
+    }
+
+    if (fp != NULL)
+    {
+	fclose(fp);
+    }
+    free(values);
+    return filled;
+}
+
+// outofcore <input> [output] [tile MiB] [scratch directory]
+int outofcore_command (int argc, char **argv)
+{
+    double sample_period = 0.0;
+    long size = count_csv_frames(argv[0], &sample_period);
+    long tile_bytes = argc > 2 && atol(argv[2]) > 0 ? atol(argv[2]) << 20 : OUT_OF_CORE_TILE_BYTES;
+    long minimum_bytes = ooc_minimum_tile_bytes(size);
+    struct OutOfCoreFft *fft = size > 1 && sample_period > 0.0 && tile_bytes >= minimum_bytes ? ooc_create(argc > 3 ? argv[3] : ".", size, tile_bytes) : NULL;
+    FILE *fp = NULL;
+    int status = 0;
+
+    // A size with a large prime factor cannot be split into small passes, so it is refused rather than loaded whole.
+    if (size > 1 && tile_bytes < minimum_bytes)
+    {
+	printf("ERROR :: %ld samples need tiles of at least %ld MiB, %ld MiB given, allow larger tiles or trim the capture to a size with smaller factors\n",
+	       size, (minimum_bytes + (1L << 20) - 1) >> 20, tile_bytes >> 20);
+    }
+    else if (fft == NULL)
+    {
+	printf("ERROR :: Failed to prepare a transform of %s\n", argv[0]);
+    }
+    else if (stream_capture(argv[0], fft) != size || !ooc_forward(fft))
+    {
+	printf("ERROR :: Failed to transform %s\n", argv[0]);
+    }
+    else if ((fp = fopen(argc > 1 ? argv[1] : "DFT.csv", "w")) == NULL)
+    {
+	printf("ERROR :: Failed to open output file for writing\n");
+    }
+    else
+    {
+	double bin_width = 1.0 / (sample_period * size);
+	long k = 0;
+
+	// Every tile must come back whole, a failed read would otherwise leave a silently short file.
+	status = 1;
+	fprintf(fp, "Frequency (Hz), Real, Imaginary\n");
+	for (int column = 0; status && column < fft->columns; column += fft->tile_columns)
+	{
+	    const double complex *bins = NULL;
+	    long count = ooc_read_bins(fft, column, &bins);
+	    long expected = (long) (fft->columns - column < fft->tile_columns ? fft->columns - column : fft->tile_columns) * fft->rows;
+
+	    status = count == expected;
+	    for (long b = 0; status && b < count; b++, k++)
+	    {
+		fprintf(fp, "%lf, %lf, %lf\n", k * bin_width, creal(*(bins + b)), cimag(*(bins + b)));
+	    }
+	}
+	if (!status)
+	{
+	    printf("ERROR :: Failed to read bins of %s after %ld of %ld\n", argv[0], k, size);
+	}
+	else if (ferror(fp))
+	{
+	    printf("ERROR :: Failed to write output file\n");
+	    status = 0;
+	}
+	status = fclose(fp) == 0 && status;
     }
-    fclose(fp);
 
-    return size;
+    ooc_free(fft);
+    return status;
 }
 
-int write_output(const char *filename, const double complex *data, int size)
+// Writes correlations against lag in seconds, one column per capture. Shorter captures leave blanks.
+int write_correlations (const char *path, double **correlations, const int *lags, int count, int first_lag, double sample_period)
 {
-    FILE *fp = fopen(filename, "w");
+    FILE *fp = fopen(path, "w");
     if (fp == NULL)
     {
 	printf("ERROR :: Failed to open output file for writing\n");
-	fclose(fp);
 	return 0;
     }
-    double fs = 1000.0;
-    fprintf(fp, "Index, Real, Imaginary\n");
-    for (int i = 0; i < size; i++)
+
+    int rows = 0;
+    fprintf(fp, "Lag (s)");
+    for (int c = 0; c < count; c++)
     {
-	fprintf(fp, "%lf, %lf, %lf\n", i * fs / 100, creal(*(data + i)), cimag(*(data + i)));
-	//fprintf(fp, "%lf, %lf, %lf\n", i * fs / 100, cabs(*(data + i)), carg(*(data + i)));
+	fprintf(fp, ", Capture %d", c + 1);
+	rows = *(lags + c) > rows ? *(lags + c) : rows;
+    }
+    fprintf(fp, "\n");
+
+    for (int i = 0; i < rows; i++)
+    {
+	fprintf(fp, "%lf", (i + first_lag) * sample_period);
+	for (int c = 0; c < count; c++)
+	{
+	    if (i < *(lags + c))
+	    {
+		fprintf(fp, ", %lf", *(*(correlations + c) + i));
+	    }
+	    else
+	    {
+		fprintf(fp, ",");
+	    }
+	}
+	fprintf(fp, "\n");
     }
     fclose(fp);
     return 1;
 }
 
-int main (void)
+/* correlate <reference> [capture]...
+ * Correlates every capture against the reference and reports each delay by peak correlation and
+ * by GCC-PHAT. With no captures, writes the reference's autocorrelation instead. */
+int correlate_command (int argc, char **argv)
 {
-    int size = 0;
-    double complex *data = NULL;
-    double complex *freq = NULL;
+    double *reference = NULL;
+    double sample_rate = 0.0;
+    int reference_length = load_capture(argv[0], &reference, &sample_rate);
+    int count = argc - 1;
+    int status = 0;
 
-    size = alloc_csv_data("../signal-generator/Test Data.csv", &data);
-    freq = calloc(size, sizeof(double complex));	
-    
-    if(data == NULL || freq == NULL)
+    if (reference_length == 0)
     {
-	printf("ERROR :: Failed to allocate memory\n");
 	return 0;
     }
+    if (count == 0)
+    {
+	double *correlation = malloc(reference_length * sizeof(double));
+	int lags = reference_length;
+	if (correlation != NULL && autocorrelate(reference, reference_length, correlation))
+	{
+	    status = write_correlations("Autocorrelation.csv", &correlation, &lags, 1, 0, 1.0 / sample_rate);
+	}
+	free(correlation);
+	free(reference);
+	return status;
+    }
 
-    DFT(data, freq, size);
-    write_output("DFT.csv", freq, size);
+    double **captures = calloc(count, sizeof(double *));
+    double **correlations = calloc(count, sizeof(double *));
+    int *lengths = calloc(count, sizeof(int));
+    int *lags = calloc(count, sizeof(int));
+    int longest = 0;
+    status = captures != NULL && correlations != NULL && lengths != NULL && lags != NULL;
+    for (int c = 0; status && c < count; c++)
+    {
+	double capture_rate = 0.0;
+	*(lengths + c) = load_capture(argv[c + 1], captures + c, &capture_rate);
+	status = *(lengths + c) > 0;
+	longest = *(lengths + c) > longest ? *(lengths + c) : longest;
+	if (status && fabs(capture_rate - sample_rate) > 1e-3 * sample_rate)
+	{
+	    printf("WARNING :: %s is sampled at %g Hz, the reference at %g Hz\n", argv[c + 1], capture_rate, sample_rate);
+	}
+    }
 
-    inverse_DFT(data, freq, size);
-    write_output("inverse DFT.csv", data, size);
+    // One correlator serves every capture, so the reference is transformed once.
+    struct Correlator *correlator = status ? correlator_create(reference, reference_length, longest, 0) : NULL;
+    for (int c = 0; correlator != NULL && c < count; c++)
+    {
+	*(lags + c) = correlator_lags(correlator, *(lengths + c));
+	*(correlations + c) = malloc(*(lags + c) * sizeof(double));
+	status = status && *(correlations + c) != NULL;
+    }
+    status = status && correlator != NULL;
 
-    free(data);
-    free(freq);
+    for (int phat = 0; status && phat < 2; phat++)
+    {
+	correlator->phat = phat;
+	for (int c = 0; status && c < count; c += 2)
+	{
+	    int pair = c + 1 < count;
+	    status = correlator_process(correlator, *(captures + c), *(lengths + c), *(correlations + c), pair ? *(captures + c + 1) : NULL, pair ? *(lengths + c + 1) : 0, pair ? *(correlations + c + 1) : NULL);
+	}
+	for (int c = 0; status && c < count; c++)
+	{
+	    double peak = 0.0;
+	    double delay = correlator_delay(correlator, *(correlations + c), *(lengths + c), &peak);
+	    printf("%s %s :: delay %.3lf samples (%.9lf s), peak %lf\n", phat ? "GCC-PHAT   " : "Correlation", argv[c + 1], delay, delay / sample_rate, peak);
+	}
+	if (status && !phat)
+	{
+	    status = write_correlations("Correlation.csv", correlations, lags, count, 1 - reference_length, 1.0 / sample_rate);
+	}
+    }
 
-    return 1;
+    correlator_free(correlator);
+    for (int c = 0; c < count; c++)
+    {
+	free(captures != NULL ? *(captures + c) : NULL);
+	free(correlations != NULL ? *(correlations + c) : NULL);
+    }
+    free(captures);
+    free(correlations);
+    free(lengths);
+    free(lags);
+    free(reference);
+    return status;
+}
+
+/* envelope <input> [output] [FIR taps]
+ * Writes the envelope, instantaneous phase and instantaneous frequency of the first channel. The
+ * whole capture goes through the FFT Hilbert transform unless FIR taps are given, in which case it
+ * is streamed through the FIR transformer and the last delay samples are not written. */
+int envelope_command (int argc, char **argv)
+{
+    double *samples = NULL;
+    double sample_rate = 0.0;
+    int size = load_capture(argv[0], &samples, &sample_rate);
+    int length = argc > 2 ? atoi(argv[2]) : 0;
+    struct HilbertFir *hilbert = size > 0 && length > 0 ? hilbert_fir_create(length) : NULL;
+    double complex *analytic = size > 0 ? malloc(size * sizeof(double complex)) : NULL;
+    double *features = size > 0 ? malloc(3 * (long) size * sizeof(double)) : NULL;
+    struct AnalyticState state = { 0.0, 0.0, sample_rate, 0 };
+    int delay = hilbert != NULL ? hilbert->delay : 0;
+    int status = 0;
+
+    if (analytic == NULL || features == NULL || (length > 0 && hilbert == NULL))
+    {
+	printf("ERROR :: Failed to prepare the Hilbert transform\n");
+    }
+    else if (hilbert != NULL)
+    {
+	hilbert_fir_process(hilbert, samples, size, analytic);
+	status = 1;
+    }
+    else
+    {
+	status = hilbert_analytic(samples, size, analytic);
+    }
+
+    FILE *fp = NULL;
+    if (status && (fp = fopen(argc > 1 ? argv[1] : "Envelope.csv", "w")) == NULL)
+    {
+	printf("ERROR :: Failed to open output file for writing\n");
+	status = 0;
+    }
+    if (status)
+    {
+	double *envelope = features;
+	double *phase = features + size;
+	double *frequency = features + 2 * (long) size;
+
+	analytic_features(&state, analytic + delay, size - delay, envelope, phase, frequency);
+	fprintf(fp, "Time (s), Signal, Envelope, Phase (rad), Frequency (Hz)\n");
+	for (int n = 0; n < size - delay; n++)
+	{
+	    fprintf(fp, "%lf, %lf, %lf, %lf, %lf\n", n / sample_rate, *(samples + n), *(envelope + n), *(phase + n), *(frequency + n));
+	}
+	fclose(fp);
+    }
+
+    hilbert_fir_free(hilbert);
+    free(analytic);
+    free(features);
+    free(samples);
+    return status;
+}
+
+/* measure [window] <capture>...
+ * Measures the fundamental of each capture and writes one row per capture. The window defaults to
+ * Blackman-Harris, whose sidelobes sit below the distortion of most converters. Rectangular and
+ * Hamming windows leak too far to separate a tone from the noise and fail. */
+int measure_command (int argc, char **argv)
+{
+    struct MeasureSettings settings = { BLACKMAN_HARRIS, KAISER_DEFAULT_BETA, MEASURE_HARMONICS };
+    char name[32] = "";
+    int first = 0;
+
+    if (sscanf(argv[0], "%31[^:]:%lf", name, &settings.kaiser_beta) >= 1 && window_parse(name, &settings.window))
+    {
+	first = 1;
+    }
+
+    FILE *fp = fopen("Measurements.csv", "w");
+    if (fp == NULL)
+    {
+	printf("ERROR :: Failed to open output file for writing\n");
+	return 0;
+    }
+    fprintf(fp, "Capture, Frequency (Hz), Amplitude, THD (dB), SNR (dB), SINAD (dB), SFDR (dBc), ENOB (bits), Noise Floor (dBc/bin)\n");
+
+    int status = first < argc;
+    for (int c = first; c < argc; c++)
+    {
+	double *samples = NULL;
+	double sample_rate = 0.0;
+	int size = load_capture(argv[c], &samples, &sample_rate);
+	struct Measurement result;
+
+	if (size == 0 || !measure_spectrum(samples, size, sample_rate, &settings, &result))
+	{
+	    printf("ERROR :: Failed to measure %s\n", argv[c]);
+	    status = 0;
+	}
+	else
+	{
+	    printf("%s :: %.3lf Hz, amplitude %lf, THD %.2lf dB, SNR %.2lf dB, SINAD %.2lf dB, SFDR %.2lf dBc, ENOB %.2lf bits, noise floor %.2lf dBc/bin\n",
+		   argv[c], result.frequency, result.amplitude, result.thd, result.snr, result.sinad, result.sfdr, result.enob, result.noise_floor);
+	    fprintf(fp, "%s, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf\n", argv[c], result.frequency, result.amplitude, result.thd, result.snr, result.sinad, result.sfdr, result.enob, result.noise_floor);
+	}
+	free(samples);
+    }
+
+    fclose(fp);
+    return status;
+}
+
+static const struct Command commands[] = {
+    { "goertzel", "goertzel <block length> <frequency,...> [input] [output]", &goertzel_command },
+    { "sliding", "sliding <window> <frequency,...> [input] [output]", &sliding_command },
+    { "spectrum", "spectrum <window> [input] [output]", &spectrum_command },
+    { "welch", "welch <segment> [input] [output] [threads] [window]", &welch_command },
+    { "outofcore", "outofcore <input> [output] [tile MiB] [scratch directory]", &outofcore_command },
+    { "correlate", "correlate <reference> [capture]...", &correlate_command },
+    { "envelope", "envelope <input> [output] [FIR taps]", &envelope_command },
+    { "measure", "measure [window] <capture>...", &measure_command }
+};
+
+int main (int argc, char **argv)
+{
+    int status = -1;
+
+    if (argc < 2)
+    {
+	status = transform_capture();
+    }
+    for (size_t i = 0; argc > 2 && status < 0 && i < sizeof commands / sizeof commands[0]; i++)
+    {
+	if (strcmp(argv[1], commands[i].name) == 0)
+	{
+	    status = commands[i].run(argc - 2, argv + 2) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+    }
+
+    // Cached plans and windows live until exit, released here so leak checkers stay quiet.
+    fft_clear_cache();
+    window_clear_cache();
+    if (status >= 0)
+    {
+	return status;
+    }
+
+    printf("Usage:\n\tdft\n");
+    for (size_t i = 0; i < sizeof commands / sizeof commands[0]; i++)
+    {
+	printf("\tdft %s\n", commands[i].usage);
+    }
+    return EXIT_FAILURE;
 }
@@ -0,0 +1,53 @@
+#ifndef DFT_TOOL
+#define DFT_TOOL
+
+/************************************************************************************************
+ * FilterTools/dft.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Discrete Fourier transform of signal generator exports.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "src/window.h"
+#include "src/outofcore.h"
+
+#include <complex.h>
+
+#define DEFAULT_INPUT "../signal-generator/Test Data.csv"
+#define MAX_BINS 64
+
+struct Command {
+	const char *name;
+	const char *usage;
+	int (*run)(int argc, char **argv);
+};
+
+int regex_test(char *pattern, char *string);
+double complex nth_root (const int n, const int N);
+void DFT (const double complex *time, double complex *freq, const int N);
+void inverse_DFT (double complex *time, const double complex *freq, const int N);
+int transform_capture (void);
+int load_capture (const char *path, double **samples, double *sample_rate);
+int parse_frequencies (const char *list, double *frequencies);
+int write_bins (const char *path, const double complex *bins, long rows, int bin_count, const double *frequencies, double row_period, double block_length);
+int write_spectrum (const char *path, const char *label, const double *values, int bins, double bin_width, int decibels);
+int parse_window (int argc, char **argv, int index, int length, const struct Window **window);
+int goertzel_command (int argc, char **argv);
+int sliding_command (int argc, char **argv);
+int spectrum_command (int argc, char **argv);
+int welch_command (int argc, char **argv);
+long stream_capture (const char *path, struct OutOfCoreFft *fft);
+int outofcore_command (int argc, char **argv);
+int write_correlations (const char *path, double **correlations, const int *lags, int count, int first_lag, double sample_period);
+int correlate_command (int argc, char **argv);
+int envelope_command (int argc, char **argv);
+int measure_command (int argc, char **argv);
+
+#endif
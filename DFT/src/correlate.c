@@ -0,0 +1,197 @@
+/************************************************************************************************
+ * FilterTools/correlate.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: FFT correlation of captures against a reference. The reference spectrum is
+ * 		  computed once and captures are correlated two per transform, with optional
+ * 		  GCC-PHAT weighting for time delay estimation.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "correlate.h"
+#include "fft.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Zero padding to reference_length + capture_length - 1 keeps negative lags from wrapping onto
+ * positive ones. Captures may be up to capture_length samples. */
+struct Correlator *correlator_create(const double *reference, int reference_length, int capture_length, int phat)
+{
+	if (reference_length < 1 || capture_length < 1)
+	{
+		return NULL;
+	}
+
+	struct Correlator *correlator = calloc(1, sizeof(struct Correlator));
+	if (correlator == NULL)
+	{
+		return NULL;
+	}
+
+	correlator->reference_length = reference_length;
+	correlator->capture_length = capture_length;
+	correlator->size = fft_next_power_of_2(reference_length + capture_length - 1);
+	correlator->phat = phat;
+	correlator->plan = fft_plan(correlator->size);
+	correlator->reference = calloc(correlator->size, sizeof(double complex));
+	correlator->work = malloc(correlator->size * sizeof(double complex));
+	if (correlator->plan == NULL || correlator->reference == NULL || correlator->work == NULL)
+	{
+		correlator_free(correlator);
+		return NULL;
+	}
+
+	for (int n = 0; n < reference_length; n++)
+	{
+		*(correlator->reference + n) = *(reference + n);
+	}
+	fft_forward(correlator->plan, correlator->reference, correlator->reference);
+	for (int k = 0; k < correlator->size; k++)
+	{
+		*(correlator->reference + k) = conj(*(correlator->reference + k));
+	}
+
+	return correlator;
+}
+
+// Lags of a capture of count samples, -(reference_length - 1) to count - 1.
+int correlator_lags(const struct Correlator *correlator, int count)
+{
+	return count + correlator->reference_length - 1;
+}
+
+static double complex weight(const struct Correlator *correlator, double complex cross, double floor)
+{
+	double magnitude = cabs(cross);
+	return !correlator->phat ? cross : magnitude > floor ? cross / magnitude : 0.0;
+}
+
+/* Correlates a against the reference into a_output, and b into b_output when b is not NULL.
+ * Output i holds lag i - (reference_length - 1), sum over n of capture[n + lag] reference[n],
+ * so a capture containing the reference delayed by d samples peaks at lag d. Both captures are
+ * real, so they share one forward and one inverse transform as its real and imaginary parts.
+ * Returns 0 if a capture is longer than the correlator accepts. */
+int correlator_process(struct Correlator *correlator, const double *a, int a_count, double *a_output, const double *b, int b_count, double *b_output)
+{
+	int size = correlator->size;
+	b_count = b != NULL ? b_count : 0;
+	if (a_count < 1 || a_count > correlator->capture_length || b_count < 0 || b_count > correlator->capture_length)
+	{
+		return 0;
+	}
+
+	double complex *z = correlator->work;
+	memset(z, 0, size * sizeof(double complex));
+	for (int n = 0; n < a_count; n++)
+	{
+		*(z + n) = *(a + n);
+	}
+	for (int n = 0; n < b_count; n++)
+	{
+		*(z + n) += I * *(b + n);
+	}
+	fft_forward(correlator->plan, z, z);
+
+	/* Separate the two spectra by conjugate symmetry, weight each cross spectrum, then recombine
+	 * as A + iB, whose inverse has the correlation of a in its real part and b in its imaginary
+	 * part. Bins k and size - k are handled together so the update can be done in place. */
+	double floor = 0.0;
+	for (int k = 0; correlator->phat && k < size; k++)
+	{
+		floor = fmax(floor, cabs(*(z + k)) * cabs(*(correlator->reference + k)));
+	}
+	floor *= CORRELATE_PHAT_FLOOR;
+
+	for (int k = 0; k <= size / 2; k++)
+	{
+		int m = (size - k) % size;
+		double complex zk = *(z + k);
+		double complex zm = *(z + m);
+		double complex ak = (zk + conj(zm)) / 2.0;
+		double complex bk = (zk - conj(zm)) / (2.0 * I);
+		double complex am = conj(ak);
+		double complex bm = conj(bk);
+
+		ak = weight(correlator, ak * *(correlator->reference + k), floor);
+		bk = weight(correlator, bk * *(correlator->reference + k), floor);
+		am = weight(correlator, am * *(correlator->reference + m), floor);
+		bm = weight(correlator, bm * *(correlator->reference + m), floor);
+		*(z + k) = ak + I * bk;
+		*(z + m) = am + I * bm;
+	}
+	fft_inverse(correlator->plan, z, z);
+
+	// Negative lags wrap to the end of the transform.
+	int negative = correlator->reference_length - 1;
+	for (int i = 0; i < correlator_lags(correlator, a_count); i++)
+	{
+		*(a_output + i) = creal(*(z + (i - negative + size) % size));
+	}
+	for (int i = 0; b_count > 0 && i < correlator_lags(correlator, b_count); i++)
+	{
+		*(b_output + i) = cimag(*(z + (i - negative + size) % size));
+	}
+	return 1;
+}
+
+/* Lag of the largest correlation, refined to a fraction of a sample by a parabola through the
+ * peak and its neighbours. peak receives the correlation there. */
+double correlator_delay(const struct Correlator *correlator, const double *correlation, int count, double *peak)
+{
+	int lags = correlator_lags(correlator, count);
+	int best = 0;
+
+	for (int i = 1; i < lags; i++)
+	{
+		best = *(correlation + i) > *(correlation + best) ? i : best;
+	}
+
+	double offset = 0.0;
+	if (best > 0 && best < lags - 1)
+	{
+		double left = *(correlation + best - 1);
+		double centre = *(correlation + best);
+		double right = *(correlation + best + 1);
+		double curvature = left - 2.0 * centre + right;
+		offset = curvature < 0.0 ? 0.5 * (left - right) / curvature : 0.0;
+	}
+
+	*peak = *(correlation + best);
+	return best - (correlator->reference_length - 1) + offset;
+}
+
+void correlator_free(struct Correlator *correlator)
+{
+	if (correlator != NULL)
+	{
+		fft_free(correlator->plan);
+		free(correlator->reference);
+		free(correlator->work);
+		free(correlator);
+	}
+}
+
+// Autocorrelation at lags 0 to count - 1, the signal correlated against itself.
+int autocorrelate(const double *samples, int count, double *output)
+{
+	struct Correlator *correlator = correlator_create(samples, count, count, 0);
+	double *full = correlator != NULL ? malloc(correlator_lags(correlator, count) * sizeof(double)) : NULL;
+	int status = full != NULL && correlator_process(correlator, samples, count, full, NULL, 0, NULL);
+
+	if (status)
+	{
+		memcpy(output, full + count - 1, count * sizeof(double));
+	}
+
+	free(full);
+	correlator_free(correlator);
+	return status;
+}
@@ -0,0 +1,42 @@
+#ifndef CORRELATE
+#define CORRELATE
+
+/************************************************************************************************
+ * FilterTools/correlate.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: FFT correlation of captures against a reference. The reference spectrum is
+ * 		  computed once and captures are correlated two per transform, with optional
+ * 		  GCC-PHAT weighting for time delay estimation.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <complex.h>
+
+#define CORRELATE_PHAT_FLOOR 1e-12	// Relative magnitude below which PHAT leaves a bin at zero
+
+struct Correlator {
+	int reference_length;
+	int capture_length;	// Longest capture accepted
+	int size;		// Transform size, covering every lag without wrapping
+	struct FftPlan *plan;
+	double complex *reference;	// Conjugate spectrum of the reference
+	double complex *work;
+	int phat;		// Weight by 1 / |cross spectrum|, keeping phase only
+};
+
+struct Correlator *correlator_create(const double *reference, int reference_length, int capture_length, int phat);
+int correlator_lags(const struct Correlator *correlator, int count);
+int correlator_process(struct Correlator *correlator, const double *a, int a_count, double *a_output, const double *b, int b_count, double *b_output);
+double correlator_delay(const struct Correlator *correlator, const double *correlation, int count, double *peak);
+void correlator_free(struct Correlator *correlator);
+
+int autocorrelate(const double *samples, int count, double *output);
+
+#endif
@@ -0,0 +1,226 @@
+/************************************************************************************************
+ * FilterTools/csv_data.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Loading of signal generator CSV exports and writing of complex results, shared
+ * 		  by the DFT and filter tools.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "csv_data.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BUFFER_SIZE 32
+#define ASCII_TO_INT(x) (x - 48)
+#define IS_ASCII_INT(x) (x >= 48 && x <= 57)
+
+int alloc_csv_data(const char *filepath, double complex **data)
+{
+    FILE *fp = fopen(filepath, "r");
+    if(fp == NULL)
+    {
+	return 0;
+    }
+    
+    char buff[BUFFER_SIZE];
+    int size = 0;
+    
+    while(fgets(buff, BUFFER_SIZE, fp))
+    {
+	size++;
+    }
+
+    *data = calloc(size - 1, sizeof(double complex));
+    fseek(fp, 0, 0);
+    size = 0;
+    fgets(buff, BUFFER_SIZE, fp);
+
+    while (fgets(buff, BUFFER_SIZE, fp))
+    {
+	int index = 0;
+	double sign = 1.0f;
+	while (index < BUFFER_SIZE && buff[index] != ' ')
+	{
+	    index++;
+	}
+	index++;
+
+	if (buff[index] == '-')
+	{
+	    sign = -1.0f;
+	    index++;
+	}
+
+	double num = 0.0f;
+	while (index < BUFFER_SIZE && IS_ASCII_INT(buff[index]) && buff[index] != '\n')
+	{
+	    num *= 10.0f;
+	    num += ASCII_TO_INT(buff[index]);
+	    index++;
+	}
+	index++;
+	double frac = 0.0f;
+	double scale = 1.0f;
+	while (index < BUFFER_SIZE && IS_ASCII_INT(buff[index]) && buff[index] != '\n')
+	{
+	    frac *= 10.0f;
+	    scale *= 10.0f;
+	    frac += ASCII_TO_INT(buff[index]);
+	    index++;
+	}
+	num += frac / scale;
+	*(*data + size) = sign * num + 0.0 * I;
+	size++;
+    }
+    fclose(fp);
+
+    return size;
+}
+
+// Writes complex values against an axis of axis_step per index, frequency bins or sample times.
+int write_output(const char *filename, const double complex *data, int size, const char *axis, double axis_step)
+{
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+	printf("ERROR :: Failed to open output file for writing\n");
+	return 0;
+    }
+    fprintf(fp, "%s, Real, Imaginary\n", axis);
+    for (int i = 0; i < size; i++)
+    {
+	fprintf(fp, "%lf, %lf, %lf\n", i * axis_step, creal(*(data + i)), cimag(*(data + i)));
+	//fprintf(fp, "%lf, %lf, %lf\n", i * axis_step, cabs(*(data + i)), carg(*(data + i)));
+    }
+    fclose(fp);
+    return 1;
+}
+
+/* Loads every signal column of a CSV export into planar arrays, channel c at *data + c * frames.
+ * The sample period is taken from the time column. Returns the frame count, 0 on failure. */
+int alloc_csv_channels(const char *filepath, double **data, int *channels, double *sample_period)
+{
+	FILE *fp = fopen(filepath, "r");
+	if (fp == NULL)
+	{
+		return 0;
+	}
+
+	char *line = NULL;
+	size_t length = 0;
+	int frames = -1;	// Header is not a frame
+
+	*data = NULL;
+	*channels = 0;
+	while (getline(&line, &length, fp) > 0)
+	{
+		if (frames < 0)
+		{
+			for (char *c = line; *c != '\0'; c++)
+			{
+				*channels += *c == ',';
+			}
+		}
+		frames++;
+	}
+
+	if (frames > 0 && *channels > 0)
+	{
+		*data = malloc((size_t) frames * *channels * sizeof(double));
+	}
+	if (*data == NULL)
+	{
+		free(line);
+		fclose(fp);
+		return 0;
+	}
+
+	double first_time = 0.0;
+	double last_time = 0.0;
+	rewind(fp);
+	getline(&line, &length, fp);
+	for (int n = 0; n < frames && getline(&line, &length, fp) > 0; n++)
+	{
+		char *end = line;
+		double time = strtod(end, &end);
+
+		first_time = n == 0 ? time : first_time;
+		last_time = time;
+		for (int c = 0; c < *channels; c++)
+		{
+			end += *end == ',';
+			*(*data + (size_t) c * frames + n) = strtod(end, &end);
+		}
+	}
+	// Times are printed to few digits, the span of the whole capture gives a precise period.
+	*sample_period = frames > 1 ? (last_time - first_time) / (frames - 1) : 0.0;
+
+	free(line);
+	fclose(fp);
+	return frames;
+}
+
+/* Counts the frames of a capture without loading it, taking the sample period from the span of
+ * its times. Returns the frame count, 0 on failure. */
+long count_csv_frames(const char *filepath, double *sample_period)
+{
+	FILE *fp = fopen(filepath, "r");
+	if (fp == NULL)
+	{
+		return 0;
+	}
+
+	char *line = NULL;
+	size_t length = 0;
+	long frames = 0;
+	double first_time = 0.0;
+	double last_time = 0.0;
+
+	while (getline(&line, &length, fp) > 0)
+	{
+		char *end = line;
+		double time = strtod(line, &end);
+		if (end != line)
+		{
+			first_time = frames == 0 ? time : first_time;
+			last_time = time;
+			frames++;
+		}
+	}
+	*sample_period = frames > 1 ? (last_time - first_time) / (frames - 1) : 0.0;
+
+	free(line);
+	fclose(fp);
+	return frames;
+}
+
+/* Reads the first channel of up to count further frames from an open capture. Lines whose time
+ * does not parse, such as the header, are skipped. Returns the frames read, 0 at the end. */
+long read_csv_frames(FILE *fp, double *values, long count)
+{
+	char *line = NULL;
+	size_t length = 0;
+	long frames = 0;
+
+	while (frames < count && getline(&line, &length, fp) > 0)
+	{
+		char *end = line;
+		strtod(line, &end);
+		if (end != line)
+		{
+			end += *end == ',';
+			*(values + frames++) = strtod(end, &end);
+		}
+	}
+
+	free(line);
+	return frames;
+}
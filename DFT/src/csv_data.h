@@ -0,0 +1,28 @@
+#ifndef CSV_DATA
+#define CSV_DATA
+
+/************************************************************************************************
+ * FilterTools/csv_data.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Loading of signal generator CSV exports and writing of complex results, shared
+ * 		  by the DFT and filter tools.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <stdio.h>
+#include <complex.h>
+
+int alloc_csv_data(const char *filepath, double complex **data);
+int write_output(const char *filename, const double complex *data, int size, const char *axis, double axis_step);
+int alloc_csv_channels(const char *filepath, double **data, int *channels, double *sample_period);
+long count_csv_frames(const char *filepath, double *sample_period);
+long read_csv_frames(FILE *fp, double *values, long count);
+
+#endif
@@ -0,0 +1,322 @@
+/************************************************************************************************
+ * FilterTools/fft.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Fast Fourier transform of any length. Powers of two use an iterative radix-2
+ * 		  transform, other lengths Bluestein's chirp-z algorithm over a padded radix-2
+ * 		  transform.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "fft.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+static struct FftPlan *plan_cache[FFT_CACHE_BUCKETS];
+
+int fft_next_power_of_2(int size)
+{
+	int power = 1;
+	while (power < size)
+	{
+		power <<= 1;
+	}
+	return power;
+}
+
+static int radix2_tables(struct FftPlan *plan)
+{
+	int size = plan->size;
+	int bits = 0;
+	while ((1 << bits) < size)
+	{
+		bits++;
+	}
+
+	plan->twiddles = malloc((size / 2 + 1) * sizeof(double complex));
+	plan->reversed = malloc(size * sizeof(int));
+	if (plan->twiddles == NULL || plan->reversed == NULL)
+	{
+		return 0;
+	}
+
+	for (int k = 0; k < size / 2; k++)
+	{
+		double angle = -2.0 * M_PI * k / size;
+		*(plan->twiddles + k) = CMPLX(cos(angle), sin(angle));
+	}
+	for (int n = 0; n < size; n++)
+	{
+		int reversed = 0;
+		for (int bit = 0; bit < bits; bit++)
+		{
+			reversed |= ((n >> bit) & 1) << (bits - 1 - bit);
+		}
+		*(plan->reversed + n) = reversed;
+	}
+	return 1;
+}
+
+static int bluestein_tables(struct FftPlan *plan)
+{
+	int size = plan->size;
+
+	plan->padded = fft_plan(fft_next_power_of_2(2 * size - 1));
+	plan->chirp = malloc(size * sizeof(double complex));
+	if (plan->padded == NULL || plan->chirp == NULL)
+	{
+		return 0;
+	}
+
+	int padded = plan->padded->size;
+	double complex *conjugate = calloc(padded, sizeof(double complex));
+	plan->chirp_spectrum = malloc(padded * sizeof(double complex));
+	if (plan->chirp_spectrum == NULL || conjugate == NULL)
+	{
+		free(conjugate);
+		return 0;
+	}
+
+	for (long n = 0; n < size; n++)
+	{
+		// n^2 is reduced modulo 2 * size first so large lengths keep full angle precision.
+		double angle = -M_PI * ((n * n) % (2L * size)) / size;
+		*(plan->chirp + n) = CMPLX(cos(angle), sin(angle));
+	}
+
+	*conjugate = conj(*(plan->chirp));
+	for (int n = 1; n < size; n++)
+	{
+		*(conjugate + n) = conj(*(plan->chirp + n));
+		*(conjugate + padded - n) = conj(*(plan->chirp + n));
+	}
+	fft_forward(plan->padded, conjugate, plan->chirp_spectrum);
+
+	free(conjugate);
+	return 1;
+}
+
+struct FftPlan *fft_plan(int size)
+{
+	if (size < 1)
+	{
+		return NULL;
+	}
+
+	struct FftPlan *plan = calloc(1, sizeof(struct FftPlan));
+	if (plan == NULL)
+	{
+		return NULL;
+	}
+
+	plan->size = size;
+	int status = (size & (size - 1)) == 0 ? radix2_tables(plan) : bluestein_tables(plan);
+	if (!status)
+	{
+		fft_free(plan);
+		return NULL;
+	}
+
+	return plan;
+}
+
+// Unscaled, input and output may be the same array. Inverse transforms use conjugate twiddles.
+static void radix2(const struct FftPlan *plan, const double complex *input, double complex *output, int inverse)
+{
+	int size = plan->size;
+
+	if (input == output)
+	{
+		for (int n = 0; n < size; n++)
+		{
+			int reversed = *(plan->reversed + n);
+			if (n < reversed)
+			{
+				double complex swap = *(output + n);
+				*(output + n) = *(output + reversed);
+				*(output + reversed) = swap;
+			}
+		}
+	}
+	else
+	{
+		for (int n = 0; n < size; n++)
+		{
+			*(output + *(plan->reversed + n)) = *(input + n);
+		}
+	}
+
+	for (int half = 1; half < size; half <<= 1)
+	{
+		int stride = size / (2 * half);
+		for (int start = 0; start < size; start += 2 * half)
+		{
+			for (int k = 0; k < half; k++)
+			{
+				double complex twiddle = *(plan->twiddles + k * stride);
+				twiddle = inverse ? conj(twiddle) : twiddle;
+
+				double complex even = *(output + start + k);
+				double complex odd = fft_cmul(*(output + start + k + half), twiddle);
+				*(output + start + k) = even + odd;
+				*(output + start + k + half) = even - odd;
+			}
+		}
+	}
+}
+
+/* Work space for Bluestein transforms, one per thread so plans hold nothing that changes and any
+ * number of threads may share one. Grown on demand and kept until fft_release_scratch(). */
+static _Thread_local double complex *scratch;
+static _Thread_local int scratch_size;
+
+// Frees the calling thread's Bluestein work space. Threads that transform call it before exiting.
+void fft_release_scratch(void)
+{
+	free(scratch);
+	scratch = NULL;
+	scratch_size = 0;
+}
+
+/* X[k] = c[k] sum x[n] c[n] conj(c[k - n]) with chirp c[n] = exp(-pi i n^2 / N). The sum is a
+ * linear convolution, evaluated with the padded radix-2 transform. If no work space can be had
+ * the output is NaN rather than left as it was. */
+static void bluestein(const struct FftPlan *plan, const double complex *input, double complex *output, int inverse)
+{
+	int size = plan->size;
+	int padded = plan->padded->size;
+
+	if (scratch_size < padded)
+	{
+		fft_release_scratch();
+		scratch = malloc(padded * sizeof(double complex));
+		scratch_size = scratch != NULL ? padded : 0;
+	}
+	if (scratch == NULL)
+	{
+		for (int k = 0; k < size; k++)
+		{
+			*(output + k) = CMPLX(NAN, NAN);
+		}
+		return;
+	}
+	double complex *work = scratch;
+
+	// An inverse transform is conj(forward(conj(x))).
+	for (int n = 0; n < size; n++)
+	{
+		double complex x = inverse ? conj(*(input + n)) : *(input + n);
+		*(work + n) = fft_cmul(x, *(plan->chirp + n));
+	}
+	for (int n = size; n < padded; n++)
+	{
+		*(work + n) = 0.0;
+	}
+
+	radix2(plan->padded, work, work, 0);
+	for (int k = 0; k < padded; k++)
+	{
+		*(work + k) = fft_cmul(*(work + k), *(plan->chirp_spectrum + k));
+	}
+	radix2(plan->padded, work, work, 1);
+
+	for (int k = 0; k < size; k++)
+	{
+		double complex X = fft_cmul(*(work + k), *(plan->chirp + k)) / padded;
+		*(output + k) = inverse ? conj(X) : X;
+	}
+}
+
+void fft_forward(const struct FftPlan *plan, const double complex *time, double complex *freq)
+{
+	if (plan->padded == NULL)
+	{
+		radix2(plan, time, freq, 0);
+	}
+	else
+	{
+		bluestein(plan, time, freq, 0);
+	}
+}
+
+// Scaled by 1 / size so that it inverts fft_forward().
+void fft_inverse(const struct FftPlan *plan, const double complex *freq, double complex *time)
+{
+	if (plan->padded == NULL)
+	{
+		radix2(plan, freq, time, 1);
+	}
+	else
+	{
+		bluestein(plan, freq, time, 1);
+	}
+
+	for (int n = 0; n < plan->size; n++)
+	{
+		*(time + n) /= plan->size;
+	}
+}
+
+void fft_free(struct FftPlan *plan)
+{
+	if (plan != NULL)
+	{
+		free(plan->twiddles);
+		free(plan->reversed);
+		fft_free(plan->padded);
+		free(plan->chirp);
+		free(plan->chirp_spectrum);
+		free(plan);
+	}
+}
+
+/* Returns a plan for size, creating it on first request, for callers that transform the same
+ * lengths repeatedly. Plans stay owned by the cache until fft_clear_cache(). The plans may be
+ * shared between threads, the cache itself is not locked, so fetch plans before starting
+ * worker threads. */
+const struct FftPlan *fft_cached_plan(int size)
+{
+	if (size < 1)
+	{
+		return NULL;
+	}
+
+	unsigned int bucket = (unsigned int) size % FFT_CACHE_BUCKETS;
+	for (struct FftPlan *plan = plan_cache[bucket]; plan != NULL; plan = plan->next)
+	{
+		if (plan->size == size)
+		{
+			return plan;
+		}
+	}
+
+	struct FftPlan *plan = fft_plan(size);
+	if (plan != NULL)
+	{
+		plan->next = plan_cache[bucket];
+		plan_cache[bucket] = plan;
+	}
+	return plan;
+}
+
+// Frees every cached plan and the calling thread's work space. Tools call it on exit.
+void fft_clear_cache(void)
+{
+	fft_release_scratch();
+	for (int bucket = 0; bucket < FFT_CACHE_BUCKETS; bucket++)
+	{
+		while (plan_cache[bucket] != NULL)
+		{
+			struct FftPlan *next = plan_cache[bucket]->next;
+			fft_free(plan_cache[bucket]);
+			plan_cache[bucket] = next;
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef FFT
+#define FFT
+
+/************************************************************************************************
+ * FilterTools/fft.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Fast Fourier transform of any length. Powers of two use an iterative radix-2
+ * 		  transform, other lengths Bluestein's chirp-z algorithm over a padded radix-2
+ * 		  transform.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <complex.h>
+
+#define FFT_CACHE_BUCKETS 32
+
+// Plain product, avoids the library call C99 complex multiplication makes for infinities.
+static inline double complex fft_cmul(double complex a, double complex b)
+{
+	double ar = creal(a), ai = cimag(a), br = creal(b), bi = cimag(b);
+	return CMPLX(ar * br - ai * bi, ar * bi + ai * br);
+}
+
+/* Precomputed tables for one transform length. Plans are not modified by transforms, so one plan
+ * may be used by several threads at once. */
+struct FftPlan {
+	int size;
+	double complex *twiddles;	// exp(-2 pi i k / size), k < size / 2, radix-2 only
+	int *reversed;			// Bit reversed index of each input, radix-2 only
+	struct FftPlan *padded;		// Radix-2 plan of at least 2 * size - 1, Bluestein only
+	double complex *chirp;		// exp(-pi i n^2 / size), n < size
+	double complex *chirp_spectrum;	// Transform of the conjugate chirp, wrapped to padded size
+	struct FftPlan *next;		// Cache chain
+};
+
+struct FftPlan *fft_plan(int size);
+void fft_forward(const struct FftPlan *plan, const double complex *time, double complex *freq);
+void fft_inverse(const struct FftPlan *plan, const double complex *freq, double complex *time);
+void fft_free(struct FftPlan *plan);
+const struct FftPlan *fft_cached_plan(int size);
+void fft_clear_cache(void);
+void fft_release_scratch(void);
+int fft_next_power_of_2(int size);
+
+#endif
@@ -0,0 +1,213 @@
+/************************************************************************************************
+ * FilterTools/goertzel.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Single bin spectral tracking. A Goertzel bank gives selected bins once per
+ * 		  block, a sliding DFT updates selected bins of a moving window every sample.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "goertzel.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Frequencies need not fall on a bin of the block, each resonator is tuned to its frequency
+ * exactly. */
+struct GoertzelBank *goertzel_create(const double *frequencies, int bin_count, double sample_rate, int block_length)
+{
+	if (bin_count < 1 || block_length < 1 || sample_rate <= 0.0)
+	{
+		return NULL;
+	}
+
+	struct GoertzelBank *bank = calloc(1, sizeof(struct GoertzelBank));
+	if (bank == NULL)
+	{
+		return NULL;
+	}
+
+	bank->bin_count = bin_count;
+	bank->block_length = block_length;
+	bank->coefficients = malloc(bin_count * sizeof(double));
+	bank->rotations = malloc(bin_count * sizeof(double complex));
+	bank->s1 = calloc(bin_count, sizeof(double));
+	bank->s2 = calloc(bin_count, sizeof(double));
+	if (bank->coefficients == NULL || bank->rotations == NULL || bank->s1 == NULL || bank->s2 == NULL)
+	{
+		goertzel_free(bank);
+		return NULL;
+	}
+
+	for (int b = 0; b < bin_count; b++)
+	{
+		double w = 2.0 * M_PI * *(frequencies + b) / sample_rate;
+		*(bank->coefficients + b) = 2.0 * cos(w);
+		*(bank->rotations + b) = cexp(-I * w);
+	}
+
+	return bank;
+}
+
+// Completed blocks the next count inputs will give, each writing one value per bin.
+long goertzel_output_limit(const struct GoertzelBank *bank, long count)
+{
+	return (bank->filled + count) / bank->block_length;
+}
+
+/* Runs every resonator over the input, the bin loop innermost so the bank vectorises across bins.
+ * At the end of each block, output receives the transform of the block at each frequency, phase
+ * referenced to the first sample of the block. Returns the number of blocks completed. */
+long goertzel_process(struct GoertzelBank *bank, const double *input, long count, double complex *output)
+{
+	double *restrict s1 = bank->s1;
+	double *restrict s2 = bank->s2;
+	const double *restrict coefficients = bank->coefficients;
+	long blocks = 0;
+
+	for (long n = 0; n < count; n++)
+	{
+		double x = *(input + n);
+		for (int b = 0; b < bank->bin_count; b++)
+		{
+			double s0 = x + *(coefficients + b) * *(s1 + b) - *(s2 + b);
+			*(s2 + b) = *(s1 + b);
+			*(s1 + b) = s0;
+		}
+
+		if (++bank->filled < bank->block_length)
+		{
+			continue;
+		}
+
+		// X(w) = exp(-i w (N - 1)) (s[N - 1] - exp(-i w) s[N - 2])
+		for (int b = 0; b < bank->bin_count; b++)
+		{
+			double complex rotation = *(bank->rotations + b);
+			double complex X = *(s1 + b) - rotation * *(s2 + b);
+			*(output + blocks * bank->bin_count + b) = X * cpow(rotation, bank->block_length - 1);
+			*(s1 + b) = 0.0;
+			*(s2 + b) = 0.0;
+		}
+		bank->filled = 0;
+		blocks++;
+	}
+
+	return blocks;
+}
+
+void goertzel_free(struct GoertzelBank *bank)
+{
+	if (bank != NULL)
+	{
+		free(bank->coefficients);
+		free(bank->rotations);
+		free(bank->s1);
+		free(bank->s2);
+		free(bank);
+	}
+}
+
+/* Each frequency is tracked at its nearest bin of the window, the sliding recursion only being
+ * exact for whole bins. */
+struct SlidingDft *sliding_dft_create(const double *frequencies, int bin_count, double sample_rate, int window)
+{
+	if (bin_count < 1 || window < 1 || sample_rate <= 0.0)
+	{
+		return NULL;
+	}
+
+	struct SlidingDft *sdft = calloc(1, sizeof(struct SlidingDft));
+	if (sdft == NULL)
+	{
+		return NULL;
+	}
+
+	sdft->bin_count = bin_count;
+	sdft->window = window;
+	sdft->bins = malloc(bin_count * sizeof(int));
+	sdft->twiddles = malloc(bin_count * sizeof(double complex));
+	sdft->values = calloc(bin_count, sizeof(double complex));
+	sdft->history = calloc(window, sizeof(double));
+	if (sdft->bins == NULL || sdft->twiddles == NULL || sdft->values == NULL || sdft->history == NULL)
+	{
+		sliding_dft_free(sdft);
+		return NULL;
+	}
+
+	for (int b = 0; b < bin_count; b++)
+	{
+		*(sdft->bins + b) = (int) lround(*(frequencies + b) * window / sample_rate);
+		*(sdft->twiddles + b) = cexp(2.0 * M_PI * I * *(sdft->bins + b) / window);
+	}
+
+	return sdft;
+}
+
+/* Rounding error accumulates in the recursion, so once per window every bin is recomputed from
+ * the history directly. That costs one window of work per window of samples, keeping the cost
+ * per sample constant while bounding the drift. */
+static void refresh_bins(struct SlidingDft *sdft)
+{
+	for (int b = 0; b < sdft->bin_count; b++)
+	{
+		double complex twiddle = *(sdft->twiddles + b);
+		double complex rotation = 1.0;
+		double complex sum = 0.0;
+
+		// Oldest sample is time 0 of the window.
+		for (int n = 0; n < sdft->window; n++)
+		{
+			sum += *(sdft->history + (sdft->index + n) % sdft->window) * conj(rotation);
+			rotation *= twiddle;
+		}
+		*(sdft->values + b) = sum;
+	}
+	sdft->since_refresh = 0;
+}
+
+/* Slides the window one sample at a time, writing every tracked bin after each sample to output,
+ * count * bin_count values. The window starts filled with zeros. */
+void sliding_dft_process(struct SlidingDft *sdft, const double *input, long count, double complex *output)
+{
+	for (long n = 0; n < count; n++)
+	{
+		double x = *(input + n);
+		double difference = x - *(sdft->history + sdft->index);
+
+		*(sdft->history + sdft->index) = x;
+		sdft->index = sdft->index + 1 < sdft->window ? sdft->index + 1 : 0;
+
+		if (++sdft->since_refresh >= sdft->window)
+		{
+			refresh_bins(sdft);
+		}
+		else
+		{
+			for (int b = 0; b < sdft->bin_count; b++)
+			{
+				*(sdft->values + b) = (*(sdft->values + b) + difference) * *(sdft->twiddles + b);
+			}
+		}
+		memcpy(output + n * sdft->bin_count, sdft->values, sdft->bin_count * sizeof(double complex));
+	}
+}
+
+void sliding_dft_free(struct SlidingDft *sdft)
+{
+	if (sdft != NULL)
+	{
+		free(sdft->bins);
+		free(sdft->twiddles);
+		free(sdft->values);
+		free(sdft->history);
+		free(sdft);
+	}
+}
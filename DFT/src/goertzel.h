@@ -0,0 +1,51 @@
+#ifndef GOERTZEL
+#define GOERTZEL
+
+/************************************************************************************************
+ * FilterTools/goertzel.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Single bin spectral tracking. A Goertzel bank gives selected bins once per
+ * 		  block, a sliding DFT updates selected bins of a moving window every sample.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <complex.h>
+
+struct GoertzelBank {
+	int bin_count;
+	int block_length;
+	int filled;		// Samples of the current block processed
+	double *coefficients;	// 2 cos(w) for each bin
+	double complex *rotations;	// exp(-i w) for each bin
+	double *s1;		// Previous two states of each bin's resonator
+	double *s2;
+};
+
+struct SlidingDft {
+	int bin_count;
+	int window;		// Samples in the transform window
+	int index;		// Oldest sample in history, next to be replaced
+	int since_refresh;
+	int *bins;		// Bin index k of each tracked bin
+	double complex *twiddles;	// exp(2 pi i k / window) for each bin
+	double complex *values;	// Current transform of the window for each bin
+	double *history;	// Last window samples, circular
+};
+
+struct GoertzelBank *goertzel_create(const double *frequencies, int bin_count, double sample_rate, int block_length);
+long goertzel_output_limit(const struct GoertzelBank *bank, long count);
+long goertzel_process(struct GoertzelBank *bank, const double *input, long count, double complex *output);
+void goertzel_free(struct GoertzelBank *bank);
+
+struct SlidingDft *sliding_dft_create(const double *frequencies, int bin_count, double sample_rate, int window);
+void sliding_dft_process(struct SlidingDft *sdft, const double *input, long count, double complex *output);
+void sliding_dft_free(struct SlidingDft *sdft);
+
+#endif
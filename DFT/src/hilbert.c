@@ -0,0 +1,158 @@
+/************************************************************************************************
+ * FilterTools/hilbert.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Analytic signals by Hilbert transform, either of a whole capture through the
+ * 		  FFT or streamed through a FIR Hilbert transformer, and the envelope,
+ * 		  instantaneous phase and instantaneous frequency derived from them.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "hilbert.h"
+#include "fft.h"
+#include "window.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Analytic signal of a whole capture. Negative frequencies are removed and positive ones doubled,
+ * DC and Nyquist kept as they are. Plans come from the FFT cache, so repeated lengths are only
+ * planned once. analytic may not alias samples. Returns 0 on failure. */
+int hilbert_analytic(const double *samples, int count, double complex *analytic)
+{
+	const struct FftPlan *plan = fft_cached_plan(count);
+	if (plan == NULL)
+	{
+		return 0;
+	}
+
+	for (int n = 0; n < count; n++)
+	{
+		*(analytic + n) = *(samples + n);
+	}
+	fft_forward(plan, analytic, analytic);
+
+	for (int k = 1; k < (count + 1) / 2; k++)
+	{
+		*(analytic + k) *= 2.0;
+	}
+	for (int k = count / 2 + 1; k < count; k++)
+	{
+		*(analytic + k) = 0.0;
+	}
+	fft_inverse(plan, analytic, analytic);
+
+	return 1;
+}
+
+/* The ideal transformer is 2 / (pi j) at odd offsets j from the centre and zero at even ones, and
+ * antisymmetric, so only the taps at positive odd offsets are stored. length is rounded up to three
+ * more than a multiple of four so the outermost taps sit at odd offsets. */
+struct HilbertFir *hilbert_fir_create(int length)
+{
+	if (length < 3)
+	{
+		return NULL;
+	}
+
+	struct HilbertFir *hilbert = calloc(1, sizeof(struct HilbertFir));
+	if (hilbert == NULL)
+	{
+		return NULL;
+	}
+
+	hilbert->length = length + (7 - length % 4) % 4;
+	hilbert->delay = (hilbert->length - 1) / 2;
+	hilbert->taps = malloc((hilbert->delay + 1) / 2 * sizeof(double));
+	hilbert->work = calloc(hilbert->length - 1 + HILBERT_BLOCK_SIZE, sizeof(double));
+
+	const struct Window *window = window_get(KAISER, hilbert->length, 1, HILBERT_KAISER_BETA);
+	if (hilbert->taps == NULL || hilbert->work == NULL || window == NULL)
+	{
+		hilbert_fir_free(hilbert);
+		return NULL;
+	}
+
+	for (int t = 0; t < (hilbert->delay + 1) / 2; t++)
+	{
+		int j = 2 * t + 1;
+		*(hilbert->taps + t) = 2.0 / (M_PI * j) * *(window->values + hilbert->delay + j);
+	}
+
+	return hilbert;
+}
+
+/* Streams count samples into analytic, continuing from the previous call. The real part is the
+ * input delayed to match the transformer, so output n corresponds to input n - delay. */
+void hilbert_fir_process(struct HilbertFir *hilbert, const double *input, long count, double complex *analytic)
+{
+	int history = hilbert->length - 1;
+	int taps = (hilbert->delay + 1) / 2;
+
+	for (long start = 0; start < count; start += HILBERT_BLOCK_SIZE)
+	{
+		int block = count - start < HILBERT_BLOCK_SIZE ? count - start : HILBERT_BLOCK_SIZE;
+
+		memcpy(hilbert->work + history, input + start, block * sizeof(double));
+		for (int n = 0; n < block; n++)
+		{
+			// work + n + delay is the input delay samples before the newest.
+			const double *centre = hilbert->work + n + hilbert->delay;
+			double sum = 0.0;
+
+			for (int t = 0; t < taps; t++)
+			{
+				int j = 2 * t + 1;
+				sum += *(hilbert->taps + t) * (*(centre - j) - *(centre + j));
+			}
+			*(analytic + start + n) = CMPLX(*centre, sum);
+		}
+		memmove(hilbert->work, hilbert->work + block, history * sizeof(double));
+	}
+}
+
+void hilbert_fir_free(struct HilbertFir *hilbert)
+{
+	if (hilbert != NULL)
+	{
+		free(hilbert->taps);
+		free(hilbert->work);
+		free(hilbert);
+	}
+}
+
+/* Envelope, unwrapped phase in radians and frequency in Hz of count analytic samples in one pass.
+ * Frequency comes from the phase step arg(z[n] conj(z[n - 1])), which never needs unwrapping,
+ * and the phase accumulates those steps. Any output may be NULL. Zero the state before the first
+ * block and set its sample rate. */
+void analytic_features(struct AnalyticState *state, const double complex *analytic, long count, double *envelope, double *phase, double *frequency)
+{
+	for (long n = 0; n < count; n++)
+	{
+		double complex z = *(analytic + n);
+		double step = state->started ? carg(z * conj(state->previous)) : 0.0;
+
+		state->phase = state->started ? state->phase + step : carg(z);
+		state->previous = z;
+		state->started = 1;
+		if (envelope != NULL)
+		{
+			*(envelope + n) = cabs(z);
+		}
+		if (phase != NULL)
+		{
+			*(phase + n) = state->phase;
+		}
+		if (frequency != NULL)
+		{
+			*(frequency + n) = step * state->sample_rate / (2.0 * M_PI);
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#ifndef HILBERT
+#define HILBERT
+
+/************************************************************************************************
+ * FilterTools/hilbert.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Analytic signals by Hilbert transform, either of a whole capture through the
+ * 		  FFT or streamed through a FIR Hilbert transformer, and the envelope,
+ * 		  instantaneous phase and instantaneous frequency derived from them.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <complex.h>
+
+#define HILBERT_BLOCK_SIZE 1024		// Input samples per streaming block
+#define HILBERT_KAISER_BETA 8.0		// Window on the FIR transformer's ideal response
+
+struct HilbertFir {
+	int length;		// Taps, three more than a multiple of four so the outermost are non-zero
+	int delay;		// Group delay in samples, (length - 1) / 2
+	double *taps;		// 2 / (pi j) windowed, for odd j = 1, 3, ... delay
+	double *work;		// length - 1 history samples followed by one block
+};
+
+// Running values carried between blocks so phase and frequency continue across them.
+struct AnalyticState {
+	double complex previous;
+	double phase;
+	double sample_rate;
+	int started;
+};
+
+int hilbert_analytic(const double *samples, int count, double complex *analytic);
+
+struct HilbertFir *hilbert_fir_create(int length);
+void hilbert_fir_process(struct HilbertFir *hilbert, const double *input, long count, double complex *analytic);
+void hilbert_fir_free(struct HilbertFir *hilbert);
+
+void analytic_features(struct AnalyticState *state, const double complex *analytic, long count, double *envelope, double *phase, double *frequency);
+
+#endif
@@ -0,0 +1,241 @@
+/************************************************************************************************
+ * FilterTools/measure.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Single tone spectral measurements. The fundamental, its harmonics, spurs and
+ * 		  noise floor are found in a windowed spectrum and reported as THD, SNR, SINAD,
+ * 		  SFDR and ENOB.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "measure.h"
+#include "fft.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+// Folds a frequency in bins into the first Nyquist zone, where an undersampled harmonic lands.
+static double fold_bin(double bin, int count)
+{
+	bin = fmod(bin, (double) count);
+	return bin > count / 2.0 ? count - bin : bin;
+}
+
+static int peak_bin(const double *power, int first, int last)
+{
+	int peak = first;
+	for (int k = first + 1; k <= last; k++)
+	{
+		peak = *(power + k) > *(power + peak) ? k : peak;
+	}
+	return peak;
+}
+
+/* Sums the power of the leakage around bin centre into *total and marks those bins used.
+ * Returns 0 without marking anything if the span overlaps bins already claimed. */
+static int claim_tone(const double *power, unsigned char *used, int bins, int centre, int span, double *total)
+{
+	int first = centre - span > 0 ? centre - span : 0;
+	int last = centre + span < bins - 1 ? centre + span : bins - 1;
+
+	for (int k = first; k <= last; k++)
+	{
+		if (*(used + k))
+		{
+			return 0;
+		}
+	}
+	*total = 0.0;
+	for (int k = first; k <= last; k++)
+	{
+		*total += *(power + k);
+		*(used + k) = 1;
+	}
+	return 1;
+}
+
+/* Fills tail with the fraction of a tone's power left outside a claim of each width up to limit
+ * bins either side of bin 0, for a tone offset bins away from it. The window is transformed at
+ * that offset and its bins are claimed outward one pair at a time. */
+static void leakage_tail(const struct Window *window, const struct FftPlan *plan, double complex *X, int count, double offset, double *tail, int limit)
+{
+	double total = 0.0;
+
+	for (int n = 0; n < count; n++)
+	{
+		*(X + n) = *(window->values + n) * cexp(2.0 * I * M_PI * offset * n / count);
+	}
+	fft_forward(plan, X, X);
+	for (int k = 0; k < count; k++)
+	{
+		total += cabs(*(X + k)) * cabs(*(X + k));
+	}
+
+	double outside = total;
+	for (int span = 0; span <= limit; span++)
+	{
+		outside -= cabs(*(X + span)) * cabs(*(X + span));
+		outside -= span > 0 ? cabs(*(X + count - span)) * cabs(*(X + count - span)) : 0.0;
+		*(tail + span) = outside > 0.0 ? outside / total : 0.0;
+	}
+}
+
+/* Narrowest claim that leaves less than MEASURE_LEAKAGE of the fundamental's power behind for a
+ * tone level times the fundamental's power, never narrower than the main lobe and a bin. Weak
+ * tones need less, so harmonics stay clear of one another. Returns 0 if limit is not enough. */
+static int leakage_span(const struct Window *window, const double *tail, int limit, double level)
+{
+	for (int span = window->half_width + 1; span <= limit; span++)
+	{
+		if (*(tail + span) * level < MEASURE_LEAKAGE)
+		{
+			return span;
+		}
+	}
+	return 0;
+}
+
+/* Measures the strongest tone of a capture. A tone's power leaks over its window's main lobe and
+ * sidelobes, so every tone is taken as the sum of the bins within a span wide enough that, were
+ * it halfway between bins, it would leave no more than MEASURE_LEAKAGE of the fundamental's power
+ * behind. Windows whose sidelobes decay slowly, rectangular and Hamming, need more than a quarter
+ * of the spectrum and fail rather than book their leakage as noise. What the fundamental still
+ * leaks past its claim at its measured offset is taken back out of the noise. The noise is the
+ * mean power of the bins no tone claimed, spread over every bin, so claimed bins count as noise
+ * at the floor's density rather than as nothing. Tables and plans come from the window and FFT
+ * caches, so repeated lengths cost three transforms and one pass over the spectrum. Returns 0 on
+ * failure. */
+int measure_spectrum(const double *samples, int count, double sample_rate, const struct MeasureSettings *settings, struct Measurement *result)
+{
+	const struct Window *window = window_get(settings->window, count, 0, settings->kaiser_beta);
+	const struct FftPlan *plan = fft_cached_plan(count);
+	int bins = count / 2 + 1;
+	int limit = bins / 4;
+	if (window == NULL || plan == NULL || limit <= window->half_width + 1)
+	{
+		return 0;
+	}
+
+	double complex *X = malloc(count * sizeof(double complex));
+	double *power = malloc(bins * sizeof(double));
+	double *tail = malloc((limit + 1) * sizeof(double));
+	unsigned char *used = calloc(bins, 1);
+	if (X == NULL || power == NULL || tail == NULL || used == NULL)
+	{
+		free(X);
+		free(power);
+		free(tail);
+		free(used);
+		return 0;
+	}
+
+	leakage_tail(window, plan, X, count, 0.5, tail, limit);
+	for (int n = 0; n < count; n++)
+	{
+		*(X + n) = *(samples + n) * *(window->values + n);
+	}
+	fft_forward(plan, X, X);
+	for (int k = 0; k < bins; k++)
+	{
+		double magnitude = cabs(*(X + k));
+		*(power + k) = (k > 0 && 2 * k != count ? 2.0 : 1.0) * magnitude * magnitude;
+	}
+
+	/* The fundamental is sought clear of DC's main lobe. DC and its leakage are neither signal nor
+	 * noise, and a fundamental whose claim would overlap DC's, or that holds no power, is no tone. */
+	int fundamental_bin = peak_bin(power, window->half_width + 2, bins - 1);
+	int span = leakage_span(window, tail, limit, 1.0);
+	int dc_span = span > 0 ? leakage_span(window, tail, span, *power / *(power + fundamental_bin)) : 0;
+	double dc = 0.0;
+	double fundamental = 0.0;
+	dc_span = dc_span > 0 ? dc_span : span;
+	if (span == 0 || !claim_tone(power, used, bins, 0, dc_span, &dc)
+		|| !claim_tone(power, used, bins, fundamental_bin, span, &fundamental) || !(fundamental > 0.0))
+	{
+		free(X);
+		free(power);
+		free(tail);
+		free(used);
+		return 0;
+	}
+
+	double weighted = 0.0;
+	for (int k = fundamental_bin - span; k <= fundamental_bin + span; k++)
+	{
+		weighted += k >= 0 && k < bins ? k * *(power + k) : 0.0;
+	}
+	double centroid = weighted / fundamental;
+
+	// Spurs are compared by lobe power like the fundamental, so scalloping does not bias SFDR.
+	double spur = 0.0;
+
+	// Each harmonic's peak is sought within a bin of where it should fold to.
+	double distortion = 0.0;
+	int harmonics = settings->harmonics < MEASURE_MAX_HARMONICS ? settings->harmonics : MEASURE_MAX_HARMONICS;
+	result->harmonic_count = 0;
+	for (int h = 2; h <= harmonics + 1; h++)
+	{
+		int expected = (int) lround(fold_bin(h * centroid, count));
+		int first = expected - 1 > 0 ? expected - 1 : 0;
+		int last = expected + 1 < bins - 1 ? expected + 1 : bins - 1;
+		int peak = peak_bin(power, first, last);
+		int harmonic_span = leakage_span(window, tail, span, *(power + peak) / *(power + fundamental_bin));
+		double harmonic = 0.0;
+
+		if (claim_tone(power, used, bins, peak, harmonic_span > 0 ? harmonic_span : span, &harmonic))
+		{
+			distortion += harmonic;
+			spur = harmonic > spur ? harmonic : spur;
+			result->harmonic_count++;
+		}
+	}
+
+	double floor = 0.0;
+	int free_bins = 0;
+	int loudest = -1;
+	for (int k = 0; k < bins; k++)
+	{
+		if (!*(used + k))
+		{
+			floor += *(power + k);
+			free_bins++;
+			loudest = loudest < 0 || *(power + k) > *(power + loudest) ? k : loudest;
+		}
+	}
+	leakage_tail(window, plan, X, count, centroid - fundamental_bin, tail, span);
+	floor -= fundamental * *(tail + span) / (1.0 - *(tail + span));
+	floor = free_bins > 0 && floor > 0.0 ? floor / free_bins : 0.0;
+
+	// The loudest unclaimed bin stands for the largest non-harmonic spur.
+	double other = 0.0;
+	int spur_span = loudest >= 0 ? leakage_span(window, tail, span, *(power + loudest) / *(power + fundamental_bin)) : 0;
+	for (int k = loudest - spur_span; loudest >= 0 && k <= loudest + spur_span; k++)
+	{
+		other += k >= 0 && k < bins && !*(used + k) ? *(power + k) : 0.0;
+	}
+	spur = other > spur ? other : spur;
+	double noise = floor * (bins - dc_span - 1);
+
+	result->frequency = centroid * sample_rate / count;
+	result->amplitude = 2.0 * sqrt(fundamental / (2.0 * count * window->energy));
+	result->thd = 10.0 * log10(distortion / fundamental);
+	result->snr = 10.0 * log10(fundamental / noise);
+	result->sinad = 10.0 * log10(fundamental / (noise + distortion));
+	result->sfdr = 10.0 * log10(fundamental / spur);
+	result->enob = (result->sinad - 1.76) / 6.02;
+	result->noise_floor = 10.0 * log10(floor / fundamental);
+
+	free(X);
+	free(power);
+	free(tail);
+	free(used);
+	return 1;
+}
@@ -0,0 +1,46 @@
+#ifndef MEASURE
+#define MEASURE
+
+/************************************************************************************************
+ * FilterTools/measure.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Single tone spectral measurements. The fundamental, its harmonics, spurs and
+ * 		  noise floor are found in a windowed spectrum and reported as THD, SNR, SINAD,
+ * 		  SFDR and ENOB.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "window.h"
+
+#define MEASURE_HARMONICS 9		// Harmonics 2 to 10 count as distortion
+#define MEASURE_MAX_HARMONICS 32
+#define MEASURE_LEAKAGE 1e-9		// Power a tone may leak past its claim, relative to the tone
+
+struct MeasureSettings {
+	enum WindowType window;
+	double kaiser_beta;
+	int harmonics;		// Harmonics above the fundamental counted as distortion
+};
+
+struct Measurement {
+	double frequency;	// Hz, fundamental
+	double amplitude;	// Fundamental peak amplitude
+	double thd;		// dB, harmonic power relative to the fundamental
+	double snr;		// dB, noise excludes harmonics and DC
+	double sinad;		// dB, noise and distortion
+	double sfdr;		// dBc, fundamental to the largest harmonic or spur
+	double enob;		// Bits, from SINAD
+	double noise_floor;	// dB relative to the fundamental, per bin
+	int harmonic_count;	// Harmonics found clear of the fundamental and DC
+};
+
+int measure_spectrum(const double *samples, int count, double sample_rate, const struct MeasureSettings *settings, struct Measurement *result);
+
+#endif
@@ -0,0 +1,280 @@
+/************************************************************************************************
+ * FilterTools/outofcore.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Out of core FFT for transforms larger than memory. Data lives in a memory
+ * 		  mapped scratch file and is transformed by the four-step method, one tile of
+ * 		  columns or rows at a time.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "outofcore.h"
+#include "fft.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/mman.h>
+
+/* The most square split of size, rows being its largest divisor not above the square root. A
+ * prime size leaves a single row, which holds the whole transform in one row pass, so
+ * ooc_minimum_tile_bytes() reports what that costs. */
+static int split_rows(long size)
+{
+	long rows = (long) sqrt((double) size);
+	while (rows > 1 && size % rows != 0)
+	{
+		rows--;
+	}
+	return rows;
+}
+
+/* Memory a transform of length works in besides its data, the radix-2 tables of about one value
+ * per point, or for any other length Bluestein's chirp with the spectrum, scratch and radix-2
+ * tables of its padded length. */
+static long transform_bytes(long length)
+{
+	long padded = 1;
+	while (padded < 2 * length - 1)
+	{
+		padded <<= 1;
+	}
+	return ((length & (length - 1)) == 0 ? length : length + 3 * padded) * (long) sizeof(double complex);
+}
+
+/* Smallest tile budget a transform of size can keep to. Each pass holds at least one whole column
+ * or row and the tables of its transform, so a size with a large prime factor, which splits into
+ * long rows transformed by Bluestein, needs several times the memory of that factor. */
+long ooc_minimum_tile_bytes(long size)
+{
+	long rows = size > 0 ? split_rows(size) : 1;
+	long columns = size > 0 ? size / rows : 1;
+	long column_pass = rows * (long) sizeof(double complex) + transform_bytes(rows);
+	long row_pass = columns * (long) sizeof(double complex) + transform_bytes(columns);
+
+	return column_pass > row_pass ? column_pass : row_pass;
+}
+
+/* Maps a scratch file of size values in directory. The file is unlinked as soon as it is open, so
+ * it disappears when the transform is freed or the process exits. tile_bytes bounds the memory
+ * each pass works on; 0 uses OUT_OF_CORE_TILE_BYTES. Returns NULL if the size cannot be split
+ * finely enough to stay within it. */
+struct OutOfCoreFft *ooc_create(const char *directory, long size, long tile_bytes)
+{
+	long rows = size > 0 ? split_rows(size) : 0;
+	tile_bytes = tile_bytes > 0 ? tile_bytes : OUT_OF_CORE_TILE_BYTES;
+	if (size < 1 || rows > INT_MAX || size / rows > INT_MAX || tile_bytes < ooc_minimum_tile_bytes(size))
+	{
+		return NULL;
+	}
+
+	struct OutOfCoreFft *fft = calloc(1, sizeof(struct OutOfCoreFft));
+	char path[4096];
+	if (fft == NULL || snprintf(path, sizeof(path), "%s/dft-scratch-XXXXXX", directory) >= (int) sizeof(path))
+	{
+		free(fft);
+		return NULL;
+	}
+
+	fft->size = size;
+	fft->rows = (int) rows;
+	fft->columns = (int) (size / rows);
+	fft->tile_bytes = tile_bytes;
+	fft->mapped_bytes = (size_t) size * sizeof(double complex);
+	fft->data = MAP_FAILED;
+
+	long tile_columns = fft->tile_bytes / ((long) fft->rows * (long) sizeof(double complex));
+	// Whole pages per row run, when the budget allows, so no page is read for a fraction of it.
+	long page_values = sysconf(_SC_PAGESIZE) / (long) sizeof(double complex);
+	tile_columns = tile_columns >= page_values ? tile_columns / page_values * page_values : tile_columns;
+	long tile_rows = fft->tile_bytes / ((long) fft->columns * (long) sizeof(double complex));
+	fft->tile_columns = tile_columns < 1 ? 1 : tile_columns > fft->columns ? fft->columns : (int) tile_columns;
+	fft->tile_rows = tile_rows < 1 ? 1 : tile_rows > fft->rows ? fft->rows : (int) tile_rows;
+
+	fft->fd = mkstemp(path);
+	if (fft->fd >= 0)
+	{
+		unlink(path);
+	}
+	if (fft->fd < 0 || ftruncate(fft->fd, (off_t) fft->mapped_bytes) != 0)
+	{
+		ooc_free(fft);
+		return NULL;
+	}
+
+	fft->data = mmap(NULL, fft->mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fft->fd, 0);
+	fft->tile = malloc((size_t) fft->rows * fft->tile_columns * sizeof(double complex));
+	fft->run = malloc((size_t) fft->tile_columns * sizeof(double complex));
+	if (fft->data == MAP_FAILED || fft->tile == NULL || fft->run == NULL)
+	{
+		ooc_free(fft);
+		return NULL;
+	}
+
+	return fft;
+}
+
+/* Writes back and drops the mapped pages holding count values from first, so resident memory
+ * stays near one tile however large the file. */
+void ooc_release(struct OutOfCoreFft *fft, long first, long count)
+{
+	long page = sysconf(_SC_PAGESIZE);
+	char *base = (char *) fft->data;
+	size_t start = (size_t) first * sizeof(double complex) / page * page;
+	size_t end = (size_t) (first + count) * sizeof(double complex);
+
+	end = end > fft->mapped_bytes ? fft->mapped_bytes : end;
+	if (end > start)
+	{
+		msync(base + start, end - start, MS_SYNC);
+		madvise(base + start, end - start, MADV_DONTNEED);
+	}
+}
+
+/* Gathers columns [first, first + count) into the tile, column-major, so each column is
+ * contiguous. Each row contributes one contiguous run, read in file order. Runs are read from the
+ * file rather than through the mapping, since touching a few values of every row through the
+ * mapping faults in whole pages of every row and the tile would no longer bound residency. */
+static int gather_columns(struct OutOfCoreFft *fft, int first, int count)
+{
+	size_t bytes = (size_t) count * sizeof(double complex);
+
+	for (int r = 0; r < fft->rows; r++)
+	{
+		off_t offset = (off_t) ((long) r * fft->columns + first) * (off_t) sizeof(double complex);
+		if (pread(fft->fd, fft->run, bytes, offset) != (ssize_t) bytes)
+		{
+			return 0;
+		}
+		for (int c = 0; c < count; c++)
+		{
+			*(fft->tile + (long) c * fft->rows + r) = *(fft->run + c);
+		}
+	}
+	return 1;
+}
+
+static int scatter_columns(struct OutOfCoreFft *fft, int first, int count)
+{
+	size_t bytes = (size_t) count * sizeof(double complex);
+
+	for (int r = 0; r < fft->rows; r++)
+	{
+		off_t offset = (off_t) ((long) r * fft->columns + first) * (off_t) sizeof(double complex);
+		for (int c = 0; c < count; c++)
+		{
+			*(fft->run + c) = *(fft->tile + (long) c * fft->rows + r);
+		}
+		if (pwrite(fft->fd, fft->run, bytes, offset) != (ssize_t) bytes)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Four-step forward transform in place. With N = rows * columns, n = columns n1 + n2 and
+ * k = k1 + rows k2:
+ *	1. transform each column over n1, giving k1
+ *	2. multiply by the twiddle exp(-2 pi i n2 k1 / N)
+ *	3. transform each row over n2, giving k2
+ * Bin k then sits at row k1, column k2, and ooc_read_bins() transposes it into order. Steps 1
+ * and 2 share one pass over column tiles, step 3 is a pass over rows. Returns 0 on failure. */
+int ooc_forward(struct OutOfCoreFft *fft)
+{
+	struct FftPlan *column_plan = fft_plan(fft->rows);
+	struct FftPlan *row_plan = fft_plan(fft->columns);
+	if (column_plan == NULL || row_plan == NULL)
+	{
+		fft_free(column_plan);
+		fft_free(row_plan);
+		return 0;
+	}
+
+	int status = 1;
+	ooc_release(fft, 0, fft->size);
+	for (int first = 0; status && first < fft->columns; first += fft->tile_columns)
+	{
+		int count = fft->columns - first < fft->tile_columns ? fft->columns - first : fft->tile_columns;
+
+		status = gather_columns(fft, first, count);
+		for (int c = 0; c < count; c++)
+		{
+			double complex *column = fft->tile + (long) c * fft->rows;
+			long n2 = first + c;
+
+			fft_forward(column_plan, column, column);
+			// n2 k1 < N, so the angle is exact before the division.
+			for (int k1 = 1; k1 < fft->rows; k1++)
+			{
+				double angle = -2.0 * M_PI * (double) (n2 * k1) / fft->size;
+				*(column + k1) *= CMPLX(cos(angle), sin(angle));
+			}
+		}
+		status = status && scatter_columns(fft, first, count);
+	}
+
+	for (int first = 0; status && first < fft->rows; first += fft->tile_rows)
+	{
+		int count = fft->rows - first < fft->tile_rows ? fft->rows - first : fft->tile_rows;
+
+		for (int r = first; r < first + count; r++)
+		{
+			double complex *row = fft->data + (long) r * fft->columns;
+			fft_forward(row_plan, row, row);
+		}
+		ooc_release(fft, (long) first * fft->columns, (long) count * fft->columns);
+	}
+
+	fft_free(column_plan);
+	fft_free(row_plan);
+	return status;
+}
+
+/* Points bins at the bins held in columns [first_column, first_column + tile_columns), in bin
+ * order. Column k2 holds bins rows k2 to rows (k2 + 1) - 1, so successive calls read the whole
+ * transform sequentially. bins stays valid until the next call. Returns the bins available. */
+long ooc_read_bins(struct OutOfCoreFft *fft, int first_column, const double complex **bins)
+{
+	if (first_column < 0 || first_column >= fft->columns)
+	{
+		return 0;
+	}
+
+	int count = fft->columns - first_column < fft->tile_columns ? fft->columns - first_column : fft->tile_columns;
+	if (!gather_columns(fft, first_column, count))
+	{
+		return 0;
+	}
+	*bins = fft->tile;
+
+	return (long) count * fft->rows;
+}
+
+void ooc_free(struct OutOfCoreFft *fft)
+{
+	if (fft != NULL)
+	{
+		if (fft->data != MAP_FAILED && fft->data != NULL)
+		{
+			munmap(fft->data, fft->mapped_bytes);
+		}
+		if (fft->fd >= 0)
+		{
+			close(fft->fd);
+		}
+		free(fft->tile);
+		free(fft->run);
+		free(fft);
+	}
+}
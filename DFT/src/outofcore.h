@@ -0,0 +1,48 @@
+#ifndef OUT_OF_CORE
+#define OUT_OF_CORE
+
+/************************************************************************************************
+ * FilterTools/outofcore.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Out of core FFT for transforms larger than memory. Data lives in a memory
+ * 		  mapped scratch file and is transformed by the four-step method, one tile of
+ * 		  columns or rows at a time.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <complex.h>
+#include <stddef.h>
+
+#define OUT_OF_CORE_TILE_BYTES (64L << 20)	// Default working set of one tile
+
+/* A transform of size rows * columns, held row-major in the scratch file. Input sample n sits at
+ * row n / columns, column n % columns. */
+struct OutOfCoreFft {
+	long size;
+	int rows;
+	int columns;
+	long tile_bytes;
+	int fd;
+	size_t mapped_bytes;
+	double complex *data;		// size values, mapped from the scratch file
+	double complex *tile;		// rows * tile_columns values
+	double complex *run;		// One row's share of a column tile
+	int tile_columns;		// Columns gathered per column pass tile
+	int tile_rows;			// Rows transformed between releases in the row pass
+};
+
+long ooc_minimum_tile_bytes(long size);
+struct OutOfCoreFft *ooc_create(const char *directory, long size, long tile_bytes);
+void ooc_release(struct OutOfCoreFft *fft, long first, long count);
+int ooc_forward(struct OutOfCoreFft *fft);
+long ooc_read_bins(struct OutOfCoreFft *fft, int first_column, const double complex **bins);
+void ooc_free(struct OutOfCoreFft *fft);
+
+#endif
@@ -0,0 +1,174 @@
+/************************************************************************************************
+ * FilterTools/welch.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Welch power spectral density estimate. Windowed, overlapping segments are
+ * 		  transformed on worker threads and their power spectra averaged.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "welch.h"
+#include "fft.h"
+#include "window.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <complex.h>
+
+// One sided bins of a real transform, DC to Nyquist.
+int welch_bins(int segment)
+{
+	return segment / 2 + 1;
+}
+
+static void accumulate_power(double *accumulator, const double complex *X, int segment)
+{
+	for (int k = 0; k < welch_bins(segment); k++)
+	{
+		double re = creal(*(X + k));
+		double im = cimag(*(X + k));
+		*(accumulator + k) += re * re + im * im;
+	}
+}
+
+/* Segments are real, so two are transformed at once as the real and imaginary parts of one
+ * complex transform and separated by conjugate symmetry, halving the transforms needed. */
+static void *welch_worker(void *arg)
+{
+	struct WelchJob *job = arg;
+	int segment = job->segment;
+	struct FftPlan *plan = fft_plan(segment);
+	double complex *packed = malloc(segment * sizeof(double complex));
+	double complex *X = malloc(segment * sizeof(double complex));
+	double complex *a = malloc(welch_bins(segment) * sizeof(double complex));
+	double complex *b = malloc(welch_bins(segment) * sizeof(double complex));
+
+	job->status = plan != NULL && packed != NULL && X != NULL && a != NULL && b != NULL;
+	for (long s = job->first; job->status && s < job->last; s += 2)
+	{
+		const double *first = job->samples + s * job->step;
+		const double *second = s + 1 < job->last ? first + job->step : NULL;
+
+		for (int n = 0; n < segment; n++)
+		{
+			double w = *(job->window + n);
+			*(packed + n) = CMPLX(w * *(first + n), second != NULL ? w * *(second + n) : 0.0);
+		}
+		fft_forward(plan, packed, X);
+
+		// A[k] = (X[k] + conj(X[N - k])) / 2, B[k] = (X[k] - conj(X[N - k])) / 2i
+		for (int k = 0; k < welch_bins(segment); k++)
+		{
+			double complex mirror = conj(*(X + (segment - k) % segment));
+			*(a + k) = (*(X + k) + mirror) / 2.0;
+			*(b + k) = (*(X + k) - mirror) / (2.0 * I);
+		}
+		accumulate_power(job->accumulator, a, segment);
+		if (second != NULL)
+		{
+			accumulate_power(job->accumulator, b, segment);
+		}
+	}
+
+	fft_free(plan);
+	fft_release_scratch();
+	free(packed);
+	free(X);
+	free(a);
+	free(b);
+	return NULL;
+}
+
+/* One sided PSD in units^2 / Hz. Segments are the window's length and overlap by overlap
+ * samples. Segments are split into contiguous shares, one per worker, and each worker sums
+ * into its own accumulator. The accumulators are reduced in worker order, so a given thread count
+ * always gives the same result. threads <= 0 uses every online processor. psd receives
+ * welch_bins(window->length) values. Returns the number of segments averaged, 0 on failure. */
+long welch_psd(const double *samples, long count, double sample_rate, const struct Window *window, int overlap, int threads, double *psd)
+{
+	int segment = window->length;
+	if (segment < 2 || overlap < 0 || overlap >= segment || count < segment || sample_rate <= 0.0)
+	{
+		return 0;
+	}
+
+	int step = segment - overlap;
+	long segments = (count - segment) / step + 1;
+	int bins = welch_bins(segment);
+
+	if (threads <= 0)
+	{
+		threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	}
+	threads = threads < 1 ? 1 : threads > WELCH_MAX_THREADS ? WELCH_MAX_THREADS : threads;
+	threads = threads > (segments + 1) / 2 ? (segments + 1) / 2 : threads;
+
+	struct WelchJob jobs[WELCH_MAX_THREADS];
+	double *accumulators = calloc((long) threads * bins, sizeof(double));
+	if (accumulators == NULL)
+	{
+		return 0;
+	}
+
+	// Shares hold an even number of segments where possible, so packed pairs are rarely split.
+	long pairs = (segments + 1) / 2;
+	for (int t = 0; t < threads; t++)
+	{
+		struct WelchJob *job = &jobs[t];
+		job->samples = samples;
+		job->segment = segment;
+		job->step = step;
+		job->window = window->values;
+		job->first = 2 * (pairs * t / threads);
+		job->last = 2 * (pairs * (t + 1) / threads);
+		job->last = job->last > segments ? segments : job->last;
+		job->accumulator = accumulators + (long) t * bins;
+		job->status = 0;
+	}
+
+	// The calling thread takes the first share. A worker that cannot be started runs inline.
+	int spawned[WELCH_MAX_THREADS] = { 0 };
+	for (int t = 1; t < threads; t++)
+	{
+		spawned[t] = pthread_create(&jobs[t].thread, NULL, &welch_worker, &jobs[t]) == 0;
+		if (!spawned[t])
+		{
+			welch_worker(&jobs[t]);
+		}
+	}
+	welch_worker(&jobs[0]);
+
+	int status = jobs[0].status;
+	memcpy(psd, jobs[0].accumulator, bins * sizeof(double));
+	for (int t = 1; t < threads; t++)
+	{
+		if (spawned[t])
+		{
+			pthread_join(jobs[t].thread, NULL);
+		}
+		status = status && jobs[t].status;
+		for (int k = 0; k < bins; k++)
+		{
+			*(psd + k) += *(jobs[t].accumulator + k);
+		}
+	}
+
+	// Bins other than DC and Nyquist fold in the power of their negative frequency.
+	double scale = 1.0 / (sample_rate * window->energy * segments);
+	for (int k = 0; k < bins; k++)
+	{
+		int folded = k > 0 && !(segment % 2 == 0 && k == segment / 2);
+		*(psd + k) *= folded ? 2.0 * scale : scale;
+	}
+
+	free(accumulators);
+	return status ? segments : 0;
+}
@@ -0,0 +1,40 @@
+#ifndef WELCH
+#define WELCH
+
+/************************************************************************************************
+ * FilterTools/welch.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Welch power spectral density estimate. Windowed, overlapping segments are
+ * 		  transformed on worker threads and their power spectra averaged.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "window.h"
+
+#include <pthread.h>
+
+#define WELCH_MAX_THREADS 64
+
+struct WelchJob {
+	const double *samples;
+	int segment;
+	int step;		// Samples between segment starts
+	const double *window;
+	long first;		// Segments [first, last) are this worker's share
+	long last;
+	double *accumulator;	// segment / 2 + 1 bins, private to the worker
+	int status;
+	pthread_t thread;
+};
+
+int welch_bins(int segment);
+long welch_psd(const double *samples, long count, double sample_rate, const struct Window *window, int overlap, int threads, double *psd);
+
+#endif
@@ -0,0 +1,206 @@
+/************************************************************************************************
+ * FilterTools/window.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Window functions for spectral analysis and FIR design. Each table is computed
+ * 		  once per type, length and parameter and cached along with the gains needed to
+ * 		  scale spectra taken through it.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "window.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+static struct Window *window_cache[WINDOW_CACHE_BUCKETS];
+
+// Zeroth order modified Bessel function of the first kind, by its power series.
+static double bessel_i0(double x)
+{
+	double term = 1.0;
+	double sum = 1.0;
+
+	for (int k = 1; k < 64 && term > 1e-17 * sum; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+// Sum of cosines a0 - a1 cos(t) + a2 cos(2t) - ..., the form of every type but Kaiser.
+static double cosine_sum(const double *a, int terms, double t)
+{
+	double value = 0.0;
+	for (int k = 0; k < terms; k++)
+	{
+		value += (k % 2 == 0 ? 1.0 : -1.0) * *(a + k) * cos(k * t);
+	}
+	return value;
+}
+
+// First null of each type, in bins from the centre of its main lobe.
+static int main_lobe_half_width(const struct Window *window)
+{
+	switch (window->type)
+	{
+		case RECTANGULAR :
+			return 1;
+		case HANN :
+		case HAMMING :
+			return 2;
+		case BLACKMAN_HARRIS :
+			return 4;
+		case FLAT_TOP :
+			return 5;
+		case KAISER :
+			return (int) ceil(sqrt(1.0 + window->parameter * window->parameter / (M_PI * M_PI)));
+	}
+	return 1;
+}
+
+/* A periodic window of length N is the first N points of the symmetric window of length N + 1,
+ * so its transform has bins falling exactly on the window's zeros. */
+static void fill_window(struct Window *window)
+{
+	static const double hann[] = { 0.5, 0.5 };
+	static const double hamming[] = { 0.54, 0.46 };
+	static const double blackman_harris[] = { 0.35875, 0.48829, 0.14128, 0.01168 };
+	static const double flat_top[] = { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 };
+	int span = window->symmetric ? window->length - 1 : window->length;
+
+	for (int n = 0; n < window->length; n++)
+	{
+		double t = span > 0 ? 2.0 * M_PI * n / span : 0.0;
+		double ratio = span > 0 ? 2.0 * n / span - 1.0 : 0.0;
+		double value = 1.0;
+
+		switch (window->type)
+		{
+			case RECTANGULAR :
+				value = 1.0;
+				break;
+			case HANN :
+				value = cosine_sum(hann, 2, t);
+				break;
+			case HAMMING :
+				value = cosine_sum(hamming, 2, t);
+				break;
+			case BLACKMAN_HARRIS :
+				value = cosine_sum(blackman_harris, 4, t);
+				break;
+			case FLAT_TOP :
+				value = cosine_sum(flat_top, 5, t);
+				break;
+			case KAISER :
+				value = bessel_i0(window->parameter * sqrt(fmax(0.0, 1.0 - ratio * ratio))) / bessel_i0(window->parameter);
+				break;
+		}
+		*(window->values + n) = span > 0 ? value : 1.0;
+	}
+
+	window->sum = 0.0;
+	window->energy = 0.0;
+	for (int n = 0; n < window->length; n++)
+	{
+		window->sum += *(window->values + n);
+		window->energy += *(window->values + n) * *(window->values + n);
+	}
+	window->coherent_gain = window->sum / window->length;
+	window->half_width = main_lobe_half_width(window);
+	window->enbw = window->sum != 0.0 ? window->length * window->energy / (window->sum * window->sum) : 0.0;
+}
+
+// Mixes the bits of the parameter rather than its value, so any double hashes safely.
+static unsigned int window_hash(enum WindowType type, int length, int symmetric, double parameter)
+{
+	uint64_t bits = 0;
+	memcpy(&bits, &parameter, sizeof(bits));
+
+	uint64_t hash = ((uint64_t) type * 31 + (uint64_t) length) * 2 + (uint64_t) symmetric;
+	hash = (hash ^ bits) * 0x9E3779B97F4A7C15ULL;
+	return (hash >> 32) % WINDOW_CACHE_BUCKETS;
+}
+
+/* Returns the window table for a type and length, computing it on first request. The parameter
+ * is Kaiser's beta and ignored otherwise. Tables stay owned by the cache until
+ * window_clear_cache(). The cache is not locked, so fetch tables before starting worker threads.
+ * Returns NULL for a length below 1. */
+const struct Window *window_get(enum WindowType type, int length, int symmetric, double parameter)
+{
+	if (length < 1 || type < RECTANGULAR || type > KAISER)
+	{
+		return NULL;
+	}
+
+	// Clears the fields a type ignores so equivalent requests share one cache entry.
+	parameter = type == KAISER ? parameter : 0.0;
+	symmetric = symmetric != 0;
+
+	unsigned int bucket = window_hash(type, length, symmetric, parameter);
+	for (struct Window *window = window_cache[bucket]; window != NULL; window = window->next)
+	{
+		if (window->type == type && window->length == length && window->symmetric == symmetric && window->parameter == parameter)
+		{
+			return window;
+		}
+	}
+
+	struct Window *window = calloc(1, sizeof(struct Window));
+	double *values = malloc(length * sizeof(double));
+	if (window == NULL || values == NULL)
+	{
+		free(window);
+		free(values);
+		return NULL;
+	}
+	window->type = type;
+	window->length = length;
+	window->symmetric = symmetric;
+	window->parameter = parameter;
+	window->values = values;
+	fill_window(window);
+
+	window->next = window_cache[bucket];
+	window_cache[bucket] = window;
+	return window;
+}
+
+// Looks up a window type by its name in WINDOW_NAMES. Returns 0 if the name is unknown.
+int window_parse(const char *name, enum WindowType *type)
+{
+	static const char *names[] = WINDOW_NAMES;
+
+	for (int i = 0; i < (int) (sizeof names / sizeof names[0]); i++)
+	{
+		if (strcmp(name, names[i]) == 0)
+		{
+			*type = (enum WindowType) i;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+void window_clear_cache(void)
+{
+	for (int bucket = 0; bucket < WINDOW_CACHE_BUCKETS; bucket++)
+	{
+		while (window_cache[bucket] != NULL)
+		{
+			struct Window *next = window_cache[bucket]->next;
+			free(window_cache[bucket]->values);
+			free(window_cache[bucket]);
+			window_cache[bucket] = next;
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#ifndef WINDOW_TABLES
+#define WINDOW_TABLES
+
+/************************************************************************************************
+ * FilterTools/window.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Window functions for spectral analysis and FIR design. Each table is computed
+ * 		  once per type, length and parameter and cached along with the gains needed to
+ * 		  scale spectra taken through it.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#define WINDOW_NAMES { "rectangular", "hann", "hamming", "blackman-harris", "flat-top", "kaiser" }
+#define WINDOW_CACHE_BUCKETS 32
+#define KAISER_DEFAULT_BETA 8.6		// About 90 dB sidelobes
+
+enum WindowType { RECTANGULAR, HANN, HAMMING, BLACKMAN_HARRIS, FLAT_TOP, KAISER };
+
+struct Window {
+	enum WindowType type;
+	int length;
+	int symmetric;		// Symmetric for FIR design, otherwise periodic for spectral analysis
+	double parameter;	// Kaiser beta, unused by other types
+	double *values;
+	double sum;		// Sum of the values
+	double energy;		// Sum of the squared values
+	double coherent_gain;	// sum / length, the amplitude gain of a bin-centred tone
+	double enbw;		// Equivalent noise bandwidth in bins, length energy / sum^2
+	int half_width;		// Main lobe half width in bins, rounded up
+	struct Window *next;	// Cache chain
+};
+
+const struct Window *window_get(enum WindowType type, int length, int symmetric, double parameter);
+int window_parse(const char *name, enum WindowType *type);
+void window_clear_cache(void);
+
+#endif
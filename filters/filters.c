@@ -0,0 +1,754 @@
+/************************************************************************************************
+ * FilterTools/filters.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Command line driver applying filters to signal generator exports.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "filters.h"
+#include "../DFT/src/csv_data.h"
+#include "../DFT/src/fft.h"
+#include "../DFT/src/window.h"
+#include "src/fir.h"
+#include "src/fast_convolution.h"
+#include "src/biquad.h"
+#include "src/design.h"
+#include "src/resample.h"
+#include "src/cic.h"
+#include "src/response.h"
+#include "src/adaptive.h"
+#include "src/fixed.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Loads every channel of a CSV export. Returns 0 on failure.
+static int load_signal(const char *path, struct Signal *signal)
+{
+	signal->frames = alloc_csv_channels(path, &signal->samples, &signal->channels, &signal->sample_period);
+	if (signal->frames == 0)
+	{
+		printf("ERROR :: Failed to read %s\n", path);
+		return 0;
+	}
+	return 1;
+}
+
+// Reads every number in a file separated by commas or whitespace. Returns the count, 0 on failure.
+static int alloc_coefficients(const char *path, double **coefficients)
+{
+	FILE *fp = fopen(path, "r");
+	if (fp == NULL)
+	{
+		printf("ERROR :: Failed to read %s\n", path);
+		return 0;
+	}
+
+	int count = 0;
+	int size = 64;
+	double value;
+	*coefficients = malloc(size * sizeof(double));
+
+	while (*coefficients != NULL && fscanf(fp, " %lf ,", &value) == 1)
+	{
+		if (count == size)
+		{
+			size *= 2;
+			double *grown = realloc(*coefficients, size * sizeof(double));
+			if (grown == NULL)
+			{
+				free(*coefficients);
+			}
+			*coefficients = grown;
+			if (grown == NULL)
+			{
+				break;
+			}
+		}
+		*(*coefficients + count++) = value;
+	}
+	fclose(fp);
+
+	if (*coefficients == NULL || count == 0)
+	{
+		printf("ERROR :: No coefficients in %s\n", path);
+		free(*coefficients);
+		*coefficients = NULL;
+		return 0;
+	}
+	return count;
+}
+
+// Writes in the signal generator export format so results can be loaded again.
+static int write_signal(const char *path, const struct Signal *signal)
+{
+	FILE *fp = fopen(path, "w");
+	if (fp == NULL)
+	{
+		printf("ERROR :: Failed to open output file for writing\n");
+		return 0;
+	}
+
+	fprintf(fp, "Time (s)");
+	for (int c = 1; c <= signal->channels; c++)
+	{
+		if (signal->channels == 1)
+		{
+			fprintf(fp, ", Filtered Signal");
+		}
+		else
+		{
+			fprintf(fp, ", Channel %d", c);
+		}
+	}
+	fprintf(fp, "\n");
+
+	for (long n = 0; n < signal->frames; n++)
+	{
+		fprintf(fp, "%lf", n * signal->sample_period);
+		for (int c = 0; c < signal->channels; c++)
+		{
+			fprintf(fp, ", %lf", *(signal->samples + c * signal->frames + n));
+		}
+		fprintf(fp, "\n");
+	}
+	fclose(fp);
+	return 1;
+}
+
+// Taps run in direct form below the crossover tap count and partitioned above, CONVOLUTION_CROSSOVER by default.
+static int fir_command(int argc, char **argv)
+{
+	double *taps = NULL;
+	struct Signal signal = { 0 };
+	int tap_count = alloc_coefficients(argv[0], &taps);
+	int status = tap_count > 0 && load_signal(argc > 1 ? argv[1] : DEFAULT_INPUT, &signal);
+
+	for (int c = 0; status && c < signal.channels; c++)
+	{
+		double *channel = signal.samples + c * signal.frames;
+		struct Convolver *convolver = convolver_create(taps, tap_count, argc > 3 ? atoi(argv[3]) : 0);
+
+		status = convolver != NULL;
+		if (status)
+		{
+			convolver_process(convolver, channel, channel, signal.frames);
+		}
+		convolver_free(convolver);
+	}
+
+	status = status && write_signal(argc > 2 ? argv[2] : DEFAULT_OUTPUT, &signal);
+	free(taps);
+	free(signal.samples);
+	return status;
+}
+
+// Coefficients are six per section, b0 b1 b2 a0 a1 a2. All channels are filtered together.
+static int biquad_command(int argc, char **argv)
+{
+	double *coefficients = NULL;
+	struct Signal signal = { 0 };
+	int count = alloc_coefficients(argv[0], &coefficients);
+	int status = count > 0 && load_signal(argc > 1 ? argv[1] : DEFAULT_INPUT, &signal);
+
+	if (status && count % 6 != 0)
+	{
+		printf("ERROR :: Biquad sections need six coefficients each\n");
+		status = 0;
+	}
+
+	struct BiquadCascade *cascade = status ? biquad_create(coefficients, count / 6, signal.channels) : NULL;
+	if (status && cascade == NULL)
+	{
+		printf("ERROR :: Biquad sections need finite coefficients and a non-zero a0\n");
+	}
+	double **channels = status ? malloc(signal.channels * sizeof(double *)) : NULL;
+	status = cascade != NULL && channels != NULL;
+	if (status)
+	{
+		for (int c = 0; c < signal.channels; c++)
+		{
+			*(channels + c) = signal.samples + c * signal.frames;
+		}
+		biquad_process(cascade, channels, signal.frames);
+		status = write_signal(argc > 2 ? argv[2] : DEFAULT_OUTPUT, &signal);
+	}
+
+	biquad_free(cascade);
+	free(channels);
+	free(coefficients);
+	free(signal.samples);
+	return status;
+}
+
+// Index of name in a list of names, -1 if absent.
+static int find_name(const char *name, const char *const *names, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		if (strcmp(name, *(names + i)) == 0)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* Parses "<method> <band> <order> <sample rate> <edge> [edge]" followed by any of transition=,
+ * ripple= and attenuation=. Returns 0 if the line is not a specification. */
+static int parse_spec(char *line, struct FilterSpec *spec)
+{
+	static const char *const methods[] = DESIGN_METHOD_NAMES;
+	static const char *const bands[] = DESIGN_BAND_NAMES;
+	char *token[5];
+	int count = 0;
+
+	memset(spec, 0, sizeof(struct FilterSpec));
+	for (char *word = strtok(line, " \t\r\n"); word != NULL; word = strtok(NULL, " \t\r\n"))
+	{
+		if (strncmp(word, "transition=", 11) == 0)
+		{
+			spec->transition = strtod(word + 11, NULL);
+		}
+		else if (strncmp(word, "ripple=", 7) == 0)
+		{
+			spec->ripple = strtod(word + 7, NULL);
+		}
+		else if (strncmp(word, "attenuation=", 12) == 0)
+		{
+			spec->attenuation = strtod(word + 12, NULL);
+		}
+		else if (count < 5)
+		{
+			token[count++] = word;
+		}
+		else
+		{
+			spec->edges[1] = strtod(word, NULL);
+		}
+	}
+	if (count < 5)
+	{
+		return 0;
+	}
+
+	int method = find_name(token[0], methods, sizeof methods / sizeof methods[0]);
+	int band = find_name(token[1], bands, sizeof bands / sizeof bands[0]);
+	spec->method = method;
+	spec->band = band;
+	spec->order = atoi(token[2]);
+	spec->sample_rate = strtod(token[3], NULL);
+	spec->edges[0] = strtod(token[4], NULL);
+
+	return method >= 0 && band >= 0;
+}
+
+/* Designs one filter per line of the specification file. Each design is written as one line of
+ * coefficients, taps for FIR methods or six per biquad section for IIR methods. Repeated
+ * specifications are served from the design cache. */
+static int design_command(int argc, char **argv)
+{
+	FILE *specs = fopen(argv[0], "r");
+	FILE *fp = specs != NULL ? fopen(argc > 1 ? argv[1] : DEFAULT_COEFFICIENTS, "w") : NULL;
+	if (fp == NULL)
+	{
+		printf("ERROR :: Failed to open %s\n", specs == NULL ? argv[0] : "output file for writing");
+		if (specs != NULL)
+		{
+			fclose(specs);
+		}
+		return 0;
+	}
+
+	char *line = NULL;
+	size_t length = 0;
+	int status = 1;
+	for (int number = 1; getline(&line, &length, specs) > 0; number++)
+	{
+		struct FilterSpec spec;
+		if (line[strspn(line, " \t\r\n")] == '\0' || line[strspn(line, " \t")] == '#')
+		{
+			continue;
+		}
+
+		const struct FilterDesign *design = parse_spec(line, &spec) ? filter_design(&spec) : NULL;
+		if (design == NULL)
+		{
+			printf("ERROR :: Invalid filter specification on line %d\n", number);
+			status = 0;
+			continue;
+		}
+
+		int count = design->fir ? design->count : 6 * design->count;
+		for (int i = 0; i < count; i++)
+		{
+			fprintf(fp, i == 0 ? "%.17g" : ", %.17g", *(design->coefficients + i));
+		}
+		fprintf(fp, "\n");
+	}
+
+	free(line);
+	fclose(specs);
+	fclose(fp);
+	filter_design_clear_cache();
+	return status;
+}
+
+/* Converts every channel to a new sample rate. Rates are rounded to whole Hz, as the time column
+ * of an export only gives the input rate to a few digits. An input rate argument overrides it.
+ * The stages' group delay is reported rather than trimmed, as it is rarely a whole sample. */
+static int resample_command(int argc, char **argv)
+{
+	struct Signal signal = { 0 };
+	int output_rate = (int) lround(strtod(argv[0], NULL));
+	int status = load_signal(argc > 1 ? argv[1] : DEFAULT_INPUT, &signal);
+	int input_rate = argc > 3 ? (int) lround(strtod(argv[3], NULL)) : signal.sample_period > 0.0 ? (int) lround(1.0 / signal.sample_period) : 0;
+	struct ResamplePlan plan;
+
+	if (status && (output_rate < 1 || input_rate < 1 || !resample_plan(output_rate, input_rate, &plan)))
+	{
+		printf("ERROR :: Cannot resample from %d Hz to %d Hz\n", input_rate, output_rate);
+		status = 0;
+	}
+
+	if (status)
+	{
+		printf("%d Hz to %d Hz in %d stages, %.1f multiply-adds per output:", input_rate, output_rate, plan.stage_count, plan.macs_per_output);
+		for (int s = 0; s < plan.stage_count; s++)
+		{
+			printf(" %d/%d (%d taps)", plan.stages[s].up, plan.stages[s].down, plan.stages[s].taps);
+		}
+		printf("\nOutput lags the input by %.2f samples\n", plan.delay);
+	}
+
+	struct Signal resampled = { NULL, signal.channels, 0, 1.0 / output_rate };
+	for (int c = 0; status && c < signal.channels; c++)
+	{
+		struct ResampleChain *chain = resample_chain_create(&plan);
+
+		status = chain != NULL;
+		if (status && resampled.samples == NULL)
+		{
+			resampled.frames = resample_chain_output_limit(chain, signal.frames);
+			resampled.samples = malloc(resampled.frames * signal.channels * sizeof(double));
+			status = resampled.samples != NULL;
+		}
+		if (status)
+		{
+			resample_chain_process(chain, signal.samples + c * signal.frames, signal.frames, resampled.samples + c * resampled.frames);
+		}
+		resample_chain_free(chain);
+	}
+
+	status = status && write_signal(argc > 2 ? argv[2] : DEFAULT_OUTPUT, &resampled);
+	filter_design_clear_cache();
+	free(signal.samples);
+	free(resampled.samples);
+	return status;
+}
+
+// CIC decimation of every channel, stages and differential delay default to 4 and 1.
+static int cic_command(int argc, char **argv)
+{
+	struct Signal signal = { 0 };
+	int decimation = atoi(argv[0]);
+	int stages = argc > 3 ? atoi(argv[3]) : 4;
+	int delay = argc > 4 ? atoi(argv[4]) : 1;
+	struct CicDecimator *cic = cic_create(decimation, stages, delay);
+
+	if (cic == NULL)
+	{
+		printf("ERROR :: A CIC decimator of that size does not fit in 64 bits\n");
+		return 0;
+	}
+
+	int status = load_signal(argc > 1 ? argv[1] : DEFAULT_INPUT, &signal);
+	struct Signal decimated = { NULL, signal.channels, cic_output_limit(cic, signal.frames), signal.sample_period * decimation };
+	decimated.samples = status ? malloc(decimated.frames * signal.channels * sizeof(double)) : NULL;
+	status = decimated.samples != NULL;
+
+	for (int c = 0; status && c < signal.channels; c++)
+	{
+		struct CicDecimator *channel = cic_create(decimation, stages, delay);
+		status = channel != NULL;
+		if (status)
+		{
+			cic_process(channel, signal.samples + c * signal.frames, signal.frames, decimated.samples + c * decimated.frames);
+		}
+		cic_free(channel);
+	}
+
+	status = status && write_signal(argc > 2 ? argv[2] : DEFAULT_OUTPUT, &decimated);
+	cic_free(cic);
+	free(signal.samples);
+	free(decimated.samples);
+	return status;
+}
+
+static int average_command(int argc, char **argv)
+{
+	struct Signal signal = { 0 };
+	int length = atoi(argv[0]);
+	int status = length > 0 && load_signal(argc > 1 ? argv[1] : DEFAULT_INPUT, &signal);
+
+	for (int c = 0; status && c < signal.channels; c++)
+	{
+		double *channel = signal.samples + c * signal.frames;
+		struct MovingAverage *average = moving_average_create(length);
+
+		status = average != NULL;
+		if (status)
+		{
+			moving_average_process(average, channel, signal.frames, channel);
+		}
+		moving_average_free(average);
+	}
+
+	status = status && write_signal(argc > 2 ? argv[2] : DEFAULT_OUTPUT, &signal);
+	free(signal.samples);
+	return status;
+}
+
+/* Writes magnitude, unwrapped phase and group delay of FIR taps or biquad sections. Values are
+ * printed to six significant figures, which keeps dense grids compact. A first and last frequency
+ * zooms the grid onto that band. */
+static int response_command(int argc, char **argv)
+{
+	double *coefficients = NULL;
+	int fir = strcmp(argv[0], "fir") == 0;
+	int count = argc > 2 && (fir || strcmp(argv[0], "biquad") == 0) ? alloc_coefficients(argv[1], &coefficients) : 0;
+	struct ResponseGrid grid = { argc > 2 ? strtod(argv[2], NULL) : 0.0, argc > 3 ? atoi(argv[3]) : RESPONSE_DEFAULT_POINTS, argc > 6, 0.0, 0.0 };
+
+	if (grid.zoom)
+	{
+		grid.first = strtod(argv[5], NULL);
+		grid.last = strtod(argv[6], NULL);
+	}
+
+	struct FrequencyResponse *response = count > 0 ? response_create(coefficients, count, fir, &grid) : NULL;
+	FILE *fp = response != NULL ? fopen(argc > 4 ? argv[4] : "Response.csv", "w") : NULL;
+	if (fp == NULL)
+	{
+		printf("ERROR :: %s\n", response == NULL ? "Failed to evaluate the response" : "Failed to open output file for writing");
+		response_free(response);
+		free(coefficients);
+		return 0;
+	}
+
+	fprintf(fp, "Frequency (Hz), Magnitude (dB), Phase (rad), Group delay (samples)\n");
+	for (int k = 0; k < response->points; k++)
+	{
+		fprintf(fp, "%.6g, %.6g, %.6g, %.6g\n", *(response->frequency + k), *(response->magnitude + k), *(response->phase + k), *(response->delay + k));
+	}
+
+	fclose(fp);
+	response_free(response);
+	free(coefficients);
+	return 1;
+}
+
+// Fraction bits of a Q format export, read from the "(Q15)" or "(Q31)" tag on its columns, 0 if untagged.
+static int tagged_fraction_bits(const char *path)
+{
+	FILE *fp = fopen(path, "r");
+	char header[256] = "";
+	int fraction_bits = 0;
+
+	if (fp != NULL && fgets(header, sizeof header, fp) != NULL)
+	{
+		fraction_bits = strstr(header, "(Q15)") != NULL ? 15 : strstr(header, "(Q31)") != NULL ? 31 : 0;
+	}
+	if (fp != NULL)
+	{
+		fclose(fp);
+	}
+	return fraction_bits;
+}
+
+/* Loads a signal as planar codes of the given format. Tagged exports hold codes of their own
+ * format and are converted, so a Q15 export run through a Q15 path is used bit for bit. Returns
+ * NULL on failure. */
+static int32_t *alloc_codes(const char *path, int fraction_bits, struct Signal *signal)
+{
+	if (!load_signal(path, signal))
+	{
+		return NULL;
+	}
+
+	int tag = tagged_fraction_bits(path);
+	int32_t *codes = malloc((size_t) signal->channels * signal->frames * sizeof(int32_t));
+	for (long i = 0; codes != NULL && i < signal->channels * signal->frames; i++)
+	{
+		*(codes + i) = fixed_from_double(ldexp(*(signal->samples + i), -tag), fraction_bits);
+	}
+	if (codes == NULL)
+	{
+		printf("ERROR :: Failed to allocate memory for %s\n", path);
+	}
+	return codes;
+}
+
+// Writes planar codes in the signal generator's Q format export layout, tagging each column.
+static int write_codes(const char *path, const int32_t *codes, const struct Signal *signal, int fraction_bits)
+{
+	FILE *fp = fopen(path, "w");
+	if (fp == NULL)
+	{
+		printf("ERROR :: Failed to open output file for writing\n");
+		return 0;
+	}
+
+	fprintf(fp, "Time (s)");
+	for (int c = 1; c <= signal->channels; c++)
+	{
+		if (signal->channels == 1)
+		{
+			fprintf(fp, ", Filtered Signal (Q%d)", fraction_bits);
+		}
+		else
+		{
+			fprintf(fp, ", Channel %d (Q%d)", c, fraction_bits);
+		}
+	}
+	fprintf(fp, "\n");
+
+	for (long n = 0; n < signal->frames; n++)
+	{
+		fprintf(fp, "%lf", n * signal->sample_period);
+		for (int c = 0; c < signal->channels; c++)
+		{
+			fprintf(fp, ", %ld", (long) *(codes + c * signal->frames + n));
+		}
+		fprintf(fp, "\n");
+	}
+	fclose(fp);
+	return 1;
+}
+
+/* Runs FIR taps or biquad sections in Q15 or Q31, as the embedded targets would, and writes the
+ * output codes. Coefficients are quantised to the same format as the samples. */
+static int fixed_command(int argc, char **argv)
+{
+	static const char *const formats[] = FIXED_FORMAT_NAMES;
+	int format = find_name(argv[0], formats, sizeof formats / sizeof formats[0]);
+	int fir = argc > 2 && strcmp(argv[1], "fir") == 0;
+
+	if (format < 0 || argc < 3 || !(fir || strcmp(argv[1], "biquad") == 0))
+	{
+		printf("ERROR :: Expected q15 or q31, fir or biquad, and a coefficient file\n");
+		return 0;
+	}
+
+	int fraction_bits = fixed_fraction_bits(format);
+	double *coefficients = NULL;
+	struct Signal signal = { 0 };
+	int count = alloc_coefficients(argv[2], &coefficients);
+	int32_t *codes = count > 0 ? alloc_codes(argc > 3 ? argv[3] : DEFAULT_INPUT, fraction_bits, &signal) : NULL;
+	int status = codes != NULL;
+
+	if (status && !fir && count % 6 != 0)
+	{
+		printf("ERROR :: Biquad sections need six coefficients each\n");
+		status = 0;
+	}
+
+	struct FixedFir *filter = status && fir ? fixed_fir_create(coefficients, count, fraction_bits) : NULL;
+	struct FixedBiquad *cascade = status && !fir ? fixed_biquad_create(coefficients, count / 6, signal.channels, fraction_bits) : NULL;
+	if (status && filter == NULL && cascade == NULL)
+	{
+		printf("ERROR :: Coefficients cannot be represented accurately in Q%d\n", fraction_bits);
+		status = 0;
+	}
+
+	for (int c = 0; status && c < signal.channels; c++)
+	{
+		int32_t *channel = codes + c * signal.frames;
+		if (fir)
+		{
+			fixed_fir_reset(filter);
+			fixed_fir_process(filter, channel, channel, signal.frames);
+		}
+		else
+		{
+			fixed_biquad_process(cascade, c, channel, signal.frames);
+		}
+	}
+
+	status = status && write_codes(argc > 4 ? argv[4] : DEFAULT_OUTPUT, codes, &signal, fraction_bits);
+	fixed_fir_free(filter);
+	fixed_biquad_free(cascade);
+	free(coefficients);
+	free(codes);
+	free(signal.samples);
+	return status;
+}
+
+/* Transforms the first channel, zero padded to a power of two, with the fixed point FFT and
+ * writes the bins up to half the sample rate as codes. Bins are the DFT divided by the size. */
+static int fixed_fft_command(int argc, char **argv)
+{
+	static const char *const formats[] = FIXED_FORMAT_NAMES;
+	int format = find_name(argv[0], formats, sizeof formats / sizeof formats[0]);
+
+	if (format < 0)
+	{
+		printf("ERROR :: Unknown fixed point format %s\n", argv[0]);
+		return 0;
+	}
+
+	int fraction_bits = fixed_fraction_bits(format);
+	struct Signal signal = { 0 };
+	int32_t *codes = alloc_codes(argc > 1 ? argv[1] : DEFAULT_INPUT, fraction_bits, &signal);
+	int size = 2;
+	while (codes != NULL && size < signal.frames)
+	{
+		size *= 2;
+	}
+
+	struct FixedFft *fft = codes != NULL ? fixed_fft_create(size, fraction_bits) : NULL;
+	int32_t *data = fft != NULL ? calloc(2 * (size_t) size, sizeof(int32_t)) : NULL;
+	FILE *fp = data != NULL ? fopen(argc > 2 ? argv[2] : "Fixed Spectrum.csv", "w") : NULL;
+	if (fp != NULL)
+	{
+		for (long n = 0; n < signal.frames; n++)
+		{
+			*(data + 2 * n) = *(codes + n);
+		}
+		fixed_fft_forward(fft, data);
+
+		double bin_width = 1.0 / (size * signal.sample_period);
+		fprintf(fp, "Frequency (Hz), Real (Q%d), Imaginary (Q%d)\n", fraction_bits, fraction_bits);
+		for (int k = 0; k <= size / 2; k++)
+		{
+			fprintf(fp, "%lf, %ld, %ld\n", k * bin_width, (long) *(data + 2 * k), (long) *(data + 2 * k + 1));
+		}
+		fclose(fp);
+	}
+	else if (codes != NULL)
+	{
+		printf("ERROR :: %s\n", data == NULL ? "Failed to create the transform" : "Failed to open output file for writing");
+	}
+
+	fixed_fft_free(fft);
+	free(data);
+	free(codes);
+	free(signal.samples);
+	return fp != NULL;
+}
+
+/* Adapts a filter from the first channel of the input towards the second, as exported by a two
+ * channel signal generator setup, and writes the filter output and error. The final weights are
+ * written as taps for the fir command. The other methods normalise their steps, so the default
+ * LMS step is scaled by 1 / (taps * input power) to match, keeping it stable at any level. */
+static int adapt_command(int argc, char **argv)
+{
+	static const char *const methods[] = ADAPTIVE_METHOD_NAMES;
+	static const double steps[] = { 0.1, 0.5, 0.5, 1.0 };
+	int method = find_name(argv[0], methods, sizeof methods / sizeof methods[0]);
+	struct Signal signal = { 0 };
+
+	if (method < 0)
+	{
+		printf("ERROR :: Unknown adaptive method %s\n", argv[0]);
+		return 0;
+	}
+	if (argc < 2 || atoi(argv[1]) < 1)
+	{
+		printf("ERROR :: Expected an adaptive method and a tap count of at least 1\n");
+		return 0;
+	}
+
+	struct AdaptiveSettings settings = { method, atoi(argv[1]), 0.0, 1e-6, 0.999 };
+	settings.forgetting = argc > 5 ? strtod(argv[5], NULL) : settings.forgetting;
+	settings.regularisation = method == RLS ? 0.01 : settings.regularisation;
+
+	int status = load_signal(argc > 2 ? argv[2] : DEFAULT_INPUT, &signal);
+	if (status && signal.channels < 2)
+	{
+		printf("ERROR :: Adaptation needs an input channel and a desired channel\n");
+		status = 0;
+	}
+
+	double power = 0.0;
+	for (long n = 0; status && method == LMS && n < signal.frames; n++)
+	{
+		power += *(signal.samples + n) * *(signal.samples + n) / signal.frames;
+	}
+	settings.step = steps[method] / (power > 0.0 && settings.taps > 0 ? settings.taps * power : 1.0);
+	settings.step = argc > 4 ? strtod(argv[4], NULL) : settings.step;
+
+	struct AdaptiveFilter *filter = status ? adaptive_create(&settings) : NULL;
+	struct Signal result = { NULL, 2, signal.frames, signal.sample_period };
+	result.samples = filter != NULL ? malloc(2 * signal.frames * sizeof(double)) : NULL;
+	double *weights = filter != NULL ? malloc(filter->padded_count * sizeof(double)) : NULL;
+	status = weights != NULL && result.samples != NULL;
+	if (status)
+	{
+		adaptive_process(filter, signal.samples, signal.samples + signal.frames, signal.frames, result.samples, result.samples + signal.frames);
+		status = write_signal(argc > 3 ? argv[3] : DEFAULT_OUTPUT, &result);
+	}
+
+	FILE *fp = status ? fopen("Adapted Coefficients.txt", "w") : NULL;
+	if (fp != NULL)
+	{
+		adaptive_weights(filter, weights);
+		for (int k = 0; k < settings.taps; k++)
+		{
+			fprintf(fp, k == 0 ? "%.17g" : ", %.17g", *(weights + k));
+		}
+		fprintf(fp, "\n");
+		fclose(fp);
+	}
+
+	adaptive_free(filter);
+	free(weights);
+	free(result.samples);
+	free(signal.samples);
+	return fp != NULL;
+}
+
+static const struct Command commands[] = {
+	{ "fir", "fir <taps> [input] [output] [crossover taps]", &fir_command },
+	{ "biquad", "biquad <sections> [input] [output]", &biquad_command },
+	{ "design", "design <specifications> [output]", &design_command },
+	{ "resample", "resample <rate> [input] [output] [input rate]", &resample_command },
+	{ "cic", "cic <decimation> [input] [output] [stages] [delay]", &cic_command },
+	{ "average", "average <length> [input] [output]", &average_command },
+	{ "adapt", "adapt <lms | nlms | fdlms | rls> <taps> [input] [output] [step] [forgetting]", &adapt_command },
+	{ "response", "response <fir | biquad> <coefficients> <sample rate> [points] [output] [first Hz] [last Hz]", &response_command },
+	{ "fixed", "fixed <q15 | q31> <fir | biquad> <coefficients> [input] [output]", &fixed_command },
+	{ "fixed-fft", "fixed-fft <q15 | q31> [input] [output]", &fixed_fft_command }
+};
+
+int main(int argc, char **argv)
+{
+	for (size_t i = 0; argc > 2 && i < sizeof commands / sizeof commands[0]; i++)
+	{
+		if (strcmp(argv[1], commands[i].name) == 0)
+		{
+			int status = commands[i].run(argc - 2, argv + 2);
+
+			// Cached designs, plans and windows live until exit, released here so leak checkers stay quiet.
+			filter_design_clear_cache();
+			fft_clear_cache();
+			window_clear_cache();
+			return status ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	printf("Usage:\n");
+	for (size_t i = 0; i < sizeof commands / sizeof commands[0]; i++)
+	{
+		printf("\tfilters %s\n", commands[i].usage);
+	}
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,35 @@
+#ifndef FILTERS
+#define FILTERS
+
+/************************************************************************************************
+ * FilterTools/filters.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Command line driver applying filters to signal generator exports.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#define DEFAULT_INPUT "../signal-generator/Test Data.csv"
+#define DEFAULT_OUTPUT "Filtered Data.csv"
+#define DEFAULT_COEFFICIENTS "Coefficients.txt"
+
+struct Signal {
+	double *samples;	// Planar, channel c starts at samples + c * frames
+	int channels;
+	long frames;
+	double sample_period;
+};
+
+struct Command {
+	const char *name;
+	const char *usage;
+	int (*run)(int argc, char **argv);
+};
+
+#endif
@@ -0,0 +1,332 @@
+/************************************************************************************************
+ * FilterTools/adaptive.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Adaptive FIR filters for system identification and echo cancellation. LMS,
+ * 		  NLMS and RLS adapt every sample, frequency domain block LMS adapts once per
+ * 		  block for long filters.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "adaptive.h"
+#include "fir.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* The sample by sample methods keep taps padded to FIR_LANES so their loops vectorise like the
+ * FIR engine's. The padding taps adapt along with the rest, lengthening the filter slightly.
+ * FDLMS pads to a power of 2 so a block is one radix-2 transform. */
+struct AdaptiveFilter *adaptive_create(const struct AdaptiveSettings *settings)
+{
+	if (settings->taps < 1 || settings->step <= 0.0 || (settings->method == RLS && (settings->taps > ADAPTIVE_RLS_MAX_TAPS || settings->forgetting <= 0.0 || settings->forgetting > 1.0 || settings->regularisation <= 0.0)))
+	{
+		return NULL;
+	}
+
+	struct AdaptiveFilter *filter = calloc(1, sizeof(struct AdaptiveFilter));
+	if (filter == NULL)
+	{
+		return NULL;
+	}
+
+	int fdlms = settings->method == FDLMS;
+	int padded = fdlms ? fft_next_power_of_2(settings->taps) : (settings->taps + FIR_LANES - 1) / FIR_LANES * FIR_LANES;
+	int size = 2 * padded;
+	int status = 1;
+
+	filter->settings = *settings;
+	filter->padded_count = padded;
+	filter->weights = fir_aligned_alloc(padded);
+	filter->work = fir_aligned_alloc(padded + (fdlms ? padded : ADAPTIVE_BLOCK_SIZE));
+	status = filter->weights != NULL && filter->work != NULL;
+
+	if (status && settings->method == RLS)
+	{
+		filter->inverse = fir_aligned_alloc((long) padded * padded);
+		filter->gain = fir_aligned_alloc(padded);
+		status = filter->inverse != NULL && filter->gain != NULL;
+	}
+	if (status && fdlms)
+	{
+		filter->plan = fft_plan(size);
+		filter->spectrum = calloc(size, sizeof(double complex));
+		filter->input_spectrum = calloc(size, sizeof(double complex));
+		filter->scratch = calloc(size, sizeof(double complex));
+		filter->power = malloc(size * sizeof(double));
+		filter->desired = calloc(padded, sizeof(double));
+		filter->ready = calloc(2 * padded, sizeof(double));
+		status = filter->plan != NULL && filter->spectrum != NULL && filter->input_spectrum != NULL && filter->scratch != NULL && filter->power != NULL && filter->desired != NULL && filter->ready != NULL;
+	}
+	if (!status)
+	{
+		adaptive_free(filter);
+		return NULL;
+	}
+
+	memset(filter->weights, 0, padded * sizeof(double));
+	memset(filter->work, 0, (padded + (fdlms ? padded : ADAPTIVE_BLOCK_SIZE)) * sizeof(double));
+	for (long i = 0; filter->inverse != NULL && i < (long) padded * padded; i++)
+	{
+		*(filter->inverse + i) = i % (padded + 1) == 0 ? 1.0 / settings->regularisation : 0.0;
+	}
+	for (int k = 0; fdlms && k < size; k++)
+	{
+		*(filter->power + k) = settings->regularisation;
+	}
+
+	return filter;
+}
+
+// Samples between an input and the output and error it produces.
+int adaptive_latency(const struct AdaptiveFilter *filter)
+{
+	return filter->settings.method == FDLMS ? filter->padded_count : 0;
+}
+
+// Partial sums across FIR_LANES accumulators keep the dot product vectorisable without reordering.
+static double dot(const double *restrict a, const double *restrict b, int length)
+{
+	double sum[FIR_LANES] = { 0.0 };
+
+	for (int j = 0; j < length; j += FIR_LANES)
+	{
+		for (int l = 0; l < FIR_LANES; l++)
+		{
+			sum[l] += *(a + j + l) * *(b + j + l);
+		}
+	}
+
+	double total = 0.0;
+	for (int l = 0; l < FIR_LANES; l++)
+	{
+		total += sum[l];
+	}
+	return total;
+}
+
+// a += scale b, the coefficient update every method shares.
+static void scaled_add(double *restrict a, const double *restrict b, double scale, int length)
+{
+	for (int j = 0; j < length; j++)
+	{
+		*(a + j) += scale * *(b + j);
+	}
+}
+
+/* RLS with the inverse correlation matrix P kept symmetric, so x^T P is (P x)^T and each sample
+ * costs one matrix-vector product and one rank one update, both over contiguous rows.
+ *	u = P x, k = u / (lambda + x^T u), w += k e, P = (P - k u^T) / lambda */
+static void rls_update(struct AdaptiveFilter *filter, const double *x, double error)
+{
+	int length = filter->padded_count;
+	double lambda = filter->settings.forgetting;
+	double *u = filter->gain;
+
+	for (int i = 0; i < length; i++)
+	{
+		*(u + i) = dot(filter->inverse + (long) i * length, x, length);
+	}
+	double denominator = lambda + dot(x, u, length);
+
+	scaled_add(filter->weights, u, error / denominator, length);
+
+	// u[i] u[j] is formed before scaling, so P stays exactly symmetric and cannot drift indefinite.
+	double inverse_denominator = 1.0 / denominator;
+	double inverse_lambda = 1.0 / lambda;
+	for (int i = 0; i < length; i++)
+	{
+		double *row = filter->inverse + (long) i * length;
+		double ui = *(u + i);
+
+		for (int j = 0; j < length; j++)
+		{
+			*(row + j) = (*(row + j) - ui * *(u + j) * inverse_denominator) * inverse_lambda;
+		}
+	}
+}
+
+static void sample_block(struct AdaptiveFilter *filter, const double *desired, int length, double *output, double *error)
+{
+	int padded = filter->padded_count;
+	double mu = filter->settings.step;
+
+	for (int n = 0; n < length; n++)
+	{
+		const double *x = filter->work + n + 1;
+		double y = dot(filter->weights, x, padded);
+		double e = *(desired + n) - y;
+
+		switch (filter->settings.method)
+		{
+			case LMS :
+				scaled_add(filter->weights, x, mu * e, padded);
+				break;
+			case NLMS :
+				filter->energy += *(x + padded - 1) * *(x + padded - 1) - *(x - 1) * *(x - 1);
+				scaled_add(filter->weights, x, mu * e / (filter->settings.regularisation + filter->energy), padded);
+				break;
+			case RLS :
+				rls_update(filter, x, e);
+				break;
+			case FDLMS :
+				break;
+		}
+		if (output != NULL)
+		{
+			*(output + n) = y;
+		}
+		if (error != NULL)
+		{
+			*(error + n) = e;
+		}
+	}
+
+	// The running energy drifts with rounding, so it is recomputed once per block.
+	filter->energy = dot(filter->work + length, filter->work + length, padded);
+}
+
+/* Constrained frequency domain block LMS by overlap-save. With L taps and a block of L samples:
+ *	Y = W X, y = last L of IFFT(Y), e = d - y
+ *	g = first L of IFFT(conj(X) E / P), with E the transform of L zeros then e
+ *	W += mu FFT(g padded with L zeros)
+ * P is a smoothed per bin input power, which normalises the step bin by bin. Dropping the second
+ * half of the gradient keeps the weights a linear rather than circular convolution. */
+static void fdlms_block(struct AdaptiveFilter *filter)
+{
+	int length = filter->padded_count;
+	int size = 2 * length;
+	double complex *X = filter->input_spectrum;
+	double complex *work = filter->scratch;
+
+	for (int n = 0; n < size; n++)
+	{
+		*(X + n) = *(filter->work + n);
+	}
+	fft_forward(filter->plan, X, X);
+	for (int k = 0; k < size; k++)
+	{
+		double magnitude = cabs(*(X + k));
+		*(filter->power + k) = ADAPTIVE_POWER_SMOOTHING * *(filter->power + k) + (1.0 - ADAPTIVE_POWER_SMOOTHING) * magnitude * magnitude;
+		*(work + k) = *(X + k) * *(filter->spectrum + k);
+	}
+	fft_inverse(filter->plan, work, work);
+
+	double *output = filter->ready;
+	double *error = filter->ready + length;
+	for (int n = 0; n < length; n++)
+	{
+		*(output + n) = creal(*(work + length + n));
+		*(error + n) = *(filter->desired + n) - *(output + n);
+		*(work + n) = 0.0;
+		*(work + length + n) = *(error + n);
+	}
+
+	fft_forward(filter->plan, work, work);
+	for (int k = 0; k < size; k++)
+	{
+		*(work + k) = conj(*(X + k)) * *(work + k) / (*(filter->power + k) + filter->settings.regularisation);
+	}
+	fft_inverse(filter->plan, work, work);
+	for (int n = length; n < size; n++)
+	{
+		*(work + n) = 0.0;
+	}
+	fft_forward(filter->plan, work, work);
+	for (int k = 0; k < size; k++)
+	{
+		*(filter->spectrum + k) += filter->settings.step * *(work + k);
+	}
+
+	memcpy(filter->work, filter->work + length, length * sizeof(double));
+}
+
+/* Adapts to count samples of input and desired signal, continuing from the previous call, and
+ * writes the filter output and error. FDLMS results lag by adaptive_latency() samples, the
+ * first block's worth being zero. output and error may be NULL. */
+void adaptive_process(struct AdaptiveFilter *filter, const double *input, const double *desired, long count, double *output, double *error)
+{
+	int padded = filter->padded_count;
+
+	if (filter->settings.method == FDLMS)
+	{
+		for (long n = 0; n < count; n++)
+		{
+			if (output != NULL)
+			{
+				*(output + n) = *(filter->ready + filter->fill);
+			}
+			if (error != NULL)
+			{
+				*(error + n) = *(filter->ready + padded + filter->fill);
+			}
+			*(filter->work + padded + filter->fill) = *(input + n);
+			*(filter->desired + filter->fill) = *(desired + n);
+			if (++filter->fill == padded)
+			{
+				fdlms_block(filter);
+				filter->fill = 0;
+			}
+		}
+		return;
+	}
+
+	for (long start = 0; start < count; start += ADAPTIVE_BLOCK_SIZE)
+	{
+		int length = count - start < ADAPTIVE_BLOCK_SIZE ? count - start : ADAPTIVE_BLOCK_SIZE;
+
+		memcpy(filter->work + padded, input + start, length * sizeof(double));
+		sample_block(filter, desired + start, length, output != NULL ? output + start : NULL, error != NULL ? error + start : NULL);
+		memmove(filter->work, filter->work + length, padded * sizeof(double));
+	}
+}
+
+/* Current weights in filter order, weights[k] applying to the input k samples ago, as taps for
+ * the FIR command. Writes the padded count of weights. */
+void adaptive_weights(const struct AdaptiveFilter *filter, double *weights)
+{
+	int padded = filter->padded_count;
+
+	if (filter->settings.method == FDLMS)
+	{
+		double complex *work = filter->scratch;
+		memcpy(work, filter->spectrum, 2 * padded * sizeof(double complex));
+		fft_inverse(filter->plan, work, work);
+		for (int k = 0; k < padded; k++)
+		{
+			*(weights + k) = creal(*(work + k));
+		}
+		return;
+	}
+
+	for (int k = 0; k < padded; k++)
+	{
+		*(weights + k) = *(filter->weights + padded - 1 - k);
+	}
+}
+
+void adaptive_free(struct AdaptiveFilter *filter)
+{
+	if (filter != NULL)
+	{
+		free(filter->weights);
+		free(filter->work);
+		free(filter->inverse);
+		free(filter->gain);
+		fft_free(filter->plan);
+		free(filter->spectrum);
+		free(filter->input_spectrum);
+		free(filter->scratch);
+		free(filter->power);
+		free(filter->desired);
+		free(filter->ready);
+		free(filter);
+	}
+}
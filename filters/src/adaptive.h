@@ -0,0 +1,61 @@
+#ifndef ADAPTIVE
+#define ADAPTIVE
+
+/************************************************************************************************
+ * FilterTools/adaptive.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Adaptive FIR filters for system identification and echo cancellation. LMS,
+ * 		  NLMS and RLS adapt every sample, frequency domain block LMS adapts once per
+ * 		  block for long filters.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "../../DFT/src/fft.h"
+
+#define ADAPTIVE_METHOD_NAMES { "lms", "nlms", "fdlms", "rls" }
+#define ADAPTIVE_BLOCK_SIZE 1024	// Samples per block for the sample by sample methods
+#define ADAPTIVE_RLS_MAX_TAPS 1024	// RLS costs taps^2 per sample
+#define ADAPTIVE_POWER_SMOOTHING 0.9	// FDLMS per bin power estimate, weight of the old estimate
+
+enum AdaptiveMethod { LMS, NLMS, FDLMS, RLS };
+
+struct AdaptiveSettings {
+	enum AdaptiveMethod method;
+	int taps;
+	double step;		// mu, normalised for NLMS and FDLMS
+	double regularisation;	// NLMS and FDLMS power floor, RLS initial inverse correlation 1 / delta
+	double forgetting;	// RLS lambda
+};
+
+struct AdaptiveFilter {
+	struct AdaptiveSettings settings;
+	int padded_count;	// Taps, rounded up to FIR_LANES or to a power of 2 for FDLMS
+	double *weights;	// Time reversed like FIR taps, weights[padded_count - 1] meets the newest input
+	double *work;		// padded_count history samples followed by one block of input
+	double energy;		// Sum of squares of the inputs under the weights, NLMS only
+	double *inverse;	// RLS inverse correlation matrix, padded_count^2
+	double *gain;		// RLS, padded_count
+	struct FftPlan *plan;		// FDLMS, 2 * padded_count
+	double complex *spectrum;	// FDLMS weight spectrum
+	double complex *input_spectrum;	// FDLMS transform of the previous and current blocks
+	double complex *scratch;	// FDLMS
+	double *power;		// FDLMS per bin input power
+	double *desired;	// FDLMS current block of desired samples
+	double *ready;		// FDLMS outputs then errors of the last completed block
+	int fill;		// FDLMS samples of the current block received
+};
+
+struct AdaptiveFilter *adaptive_create(const struct AdaptiveSettings *settings);
+int adaptive_latency(const struct AdaptiveFilter *filter);
+void adaptive_process(struct AdaptiveFilter *filter, const double *input, const double *desired, long count, double *output, double *error);
+void adaptive_weights(const struct AdaptiveFilter *filter, double *weights);
+void adaptive_free(struct AdaptiveFilter *filter);
+
+#endif
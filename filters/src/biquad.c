@@ -0,0 +1,182 @@
+/************************************************************************************************
+ * FilterTools/biquad.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Cascaded biquad IIR filtering in transposed direct form II. Channels are
+ * 		  processed in groups of BIQUAD_LANES, one channel per vector lane.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "biquad.h"
+#include "fir.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef __SSE2__
+#include <xmmintrin.h>
+#define MXCSR_FLUSH_DENORMALS 0x8040	// Flush to zero and denormals are zero
+#endif
+
+/* Coefficients are six per section, b0 b1 b2 a0 a1 a2, as exported by most design tools. Each
+ * section is normalised by its a0. Returns NULL if a section's a0 is zero or any coefficient is
+ * not finite. */
+struct BiquadCascade *biquad_create(const double *coefficients, int section_count, int channels)
+{
+	if (section_count < 1 || channels < 1)
+	{
+		return NULL;
+	}
+
+	struct BiquadCascade *cascade = calloc(1, sizeof(struct BiquadCascade));
+	if (cascade == NULL)
+	{
+		return NULL;
+	}
+
+	cascade->section_count = section_count;
+	cascade->channels = channels;
+	cascade->groups = (channels + BIQUAD_LANES - 1) / BIQUAD_LANES;
+	cascade->sections = malloc(section_count * sizeof(struct BiquadSection));
+	cascade->state = fir_aligned_alloc(cascade->groups * section_count * 2 * BIQUAD_LANES);
+	cascade->lanes = fir_aligned_alloc(BIQUAD_BLOCK_SIZE * BIQUAD_LANES);
+	if (cascade->sections == NULL || cascade->state == NULL || cascade->lanes == NULL)
+	{
+		biquad_free(cascade);
+		return NULL;
+	}
+
+	for (int s = 0; s < section_count; s++)
+	{
+		const double *c = coefficients + 6 * s;
+		double a0 = *(c + 3);
+		struct BiquadSection *section = cascade->sections + s;
+
+		for (int k = 0; k < 6; k++)
+		{
+			a0 = isfinite(*(c + k)) ? a0 : 0.0;
+		}
+		if (a0 == 0.0)
+		{
+			biquad_free(cascade);
+			return NULL;
+		}
+
+		section->b0 = *(c + 0) / a0;
+		section->b1 = *(c + 1) / a0;
+		section->b2 = *(c + 2) / a0;
+		section->a1 = *(c + 4) / a0;
+		section->a2 = *(c + 5) / a0;
+	}
+	biquad_reset(cascade);
+
+	return cascade;
+}
+
+void biquad_reset(struct BiquadCascade *cascade)
+{
+	memset(cascade->state, 0, cascade->groups * cascade->section_count * 2 * BIQUAD_LANES * sizeof(double));
+}
+
+/* One section over one block of interleaved lanes, in place. The recursion is serial in time, so
+ * the inner loop runs across lanes, which are independent channels and vectorise. */
+static void section_block(const struct BiquadSection *section, double *restrict state, double *restrict lanes, int length)
+{
+	double s1[BIQUAD_LANES];
+	double s2[BIQUAD_LANES];
+	double b0 = section->b0, b1 = section->b1, b2 = section->b2, a1 = section->a1, a2 = section->a2;
+
+	memcpy(s1, state, sizeof(s1));
+	memcpy(s2, state + BIQUAD_LANES, sizeof(s2));
+
+	for (int n = 0; n < length; n++)
+	{
+		double *x = lanes + n * BIQUAD_LANES;
+		for (int l = 0; l < BIQUAD_LANES; l++)
+		{
+			double y = b0 * *(x + l) + s1[l];
+			s1[l] = b1 * *(x + l) - a1 * y + s2[l];
+			s2[l] = b2 * *(x + l) - a2 * y;
+			*(x + l) = y;
+		}
+	}
+
+#ifndef __SSE2__
+	// Without flush to zero a decaying recursion would drift into denormals once the input falls silent.
+	for (int l = 0; l < BIQUAD_LANES; l++)
+	{
+		s1[l] = fpclassify(s1[l]) == FP_SUBNORMAL ? 0.0 : s1[l];
+		s2[l] = fpclassify(s2[l]) == FP_SUBNORMAL ? 0.0 : s2[l];
+	}
+#endif
+	memcpy(state, s1, sizeof(s1));
+	memcpy(state + BIQUAD_LANES, s2, sizeof(s2));
+}
+
+/* Filters count samples of every channel in place, continuing from the previous call. Channels
+ * are planar, channels[c] holding count samples of channel c. */
+void biquad_process(struct BiquadCascade *cascade, double *const *channels, long count)
+{
+#ifdef __SSE2__
+	unsigned int mxcsr = _mm_getcsr();
+	_mm_setcsr(mxcsr | MXCSR_FLUSH_DENORMALS);
+#endif
+
+	for (int group = 0; group < cascade->groups; group++)
+	{
+		int first = group * BIQUAD_LANES;
+		int used = cascade->channels - first < BIQUAD_LANES ? cascade->channels - first : BIQUAD_LANES;
+		double *state = cascade->state + group * cascade->section_count * 2 * BIQUAD_LANES;
+
+		for (long start = 0; start < count; start += BIQUAD_BLOCK_SIZE)
+		{
+			int length = count - start < BIQUAD_BLOCK_SIZE ? count - start : BIQUAD_BLOCK_SIZE;
+
+			memset(cascade->lanes, 0, BIQUAD_BLOCK_SIZE * BIQUAD_LANES * sizeof(double));
+			for (int l = 0; l < used; l++)
+			{
+				const double *input = *(channels + first + l) + start;
+				for (int n = 0; n < length; n++)
+				{
+					*(cascade->lanes + n * BIQUAD_LANES + l) = *(input + n);
+				}
+			}
+
+			for (int s = 0; s < cascade->section_count; s++)
+			{
+				section_block(cascade->sections + s, state + s * 2 * BIQUAD_LANES, cascade->lanes, length);
+			}
+
+			for (int l = 0; l < used; l++)
+			{
+				double *output = *(channels + first + l) + start;
+				for (int n = 0; n < length; n++)
+				{
+					*(output + n) = *(cascade->lanes + n * BIQUAD_LANES + l);
+				}
+			}
+		}
+	}
+
+#ifdef __SSE2__
+	_mm_setcsr(mxcsr);
+#endif
+}
+
+void biquad_free(struct BiquadCascade *cascade)
+{
+	if (cascade != NULL)
+	{
+		free(cascade->sections);
+		free(cascade->state);
+		free(cascade->lanes);
+		free(cascade);
+	}
+}
@@ -0,0 +1,45 @@
+#ifndef BIQUAD
+#define BIQUAD
+
+/************************************************************************************************
+ * FilterTools/biquad.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Cascaded biquad IIR filtering in transposed direct form II. Channels are
+ * 		  processed in groups of BIQUAD_LANES, one channel per vector lane.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#define BIQUAD_LANES 8
+#define BIQUAD_BLOCK_SIZE 256	// Samples per channel per block
+
+// Coefficients normalised so that a0 = 1.
+struct BiquadSection {
+	double b0;
+	double b1;
+	double b2;
+	double a1;
+	double a2;
+};
+
+struct BiquadCascade {
+	int section_count;
+	int channels;
+	int groups;			// Channel groups of BIQUAD_LANES
+	struct BiquadSection *sections;	// Shared by all channels
+	double *state;			// Two delays per section per lane, grouped lane innermost
+	double *lanes;			// One block of interleaved lane samples
+};
+
+struct BiquadCascade *biquad_create(const double *coefficients, int section_count, int channels);
+void biquad_reset(struct BiquadCascade *cascade);
+void biquad_process(struct BiquadCascade *cascade, double *const *channels, long count);
+void biquad_free(struct BiquadCascade *cascade);
+
+#endif
@@ -0,0 +1,163 @@
+/************************************************************************************************
+ * FilterTools/cic.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Cascaded integrator-comb decimators and recursive moving averages. Both run on
+ * 		  fixed point integer accumulators, so their running sums are exact and never drift.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "cic.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+// Rounds to fixed point, saturating at the limits of the 32 bit input word.
+int32_t cic_quantise(double x)
+{
+	double level = nearbyint(ldexp(x, CIC_FRACTION_BITS));
+
+	if (level >= INT32_MAX)
+	{
+		return INT32_MAX;
+	}
+	if (level <= INT32_MIN)
+	{
+		return INT32_MIN;
+	}
+	return (int32_t) level;
+}
+
+/* Integrators overflow freely. Arithmetic is modulo 2^64 and the combs take differences, so the
+ * output is exact as long as it fits, which needs CIC_INPUT_BITS + stages * log2(decimation *
+ * delay) bits. Returns NULL if that exceeds 64. */
+struct CicDecimator *cic_create(int decimation, int stages, int delay)
+{
+	if (decimation < 1 || stages < 1 || stages > CIC_MAX_STAGES || delay < 1 || delay > CIC_MAX_DELAY)
+	{
+		return NULL;
+	}
+
+	double growth = stages * log2((double) decimation * delay);
+	if (CIC_INPUT_BITS + ceil(growth) > 64)
+	{
+		return NULL;
+	}
+
+	struct CicDecimator *cic = calloc(1, sizeof(struct CicDecimator));
+	if (cic == NULL)
+	{
+		return NULL;
+	}
+
+	cic->stages = stages;
+	cic->decimation = decimation;
+	cic->delay = delay;
+	cic->scale = 1.0 / (pow((double) decimation * delay, stages) * ldexp(1.0, CIC_FRACTION_BITS));
+
+	return cic;
+}
+
+long cic_output_limit(const struct CicDecimator *cic, long count)
+{
+	return (cic->phase + count) / cic->decimation;
+}
+
+/* Integrates every input and runs the combs on every decimation'th. Returns the number of outputs
+ * written, output must hold cic_output_limit() samples. */
+long cic_process(struct CicDecimator *cic, const double *input, long count, double *output)
+{
+	long produced = 0;
+
+	for (long n = 0; n < count; n++)
+	{
+		uint64_t x = (uint64_t) (int64_t) cic_quantise(*(input + n));
+
+		for (int s = 0; s < cic->stages; s++)
+		{
+			cic->integrators[s] += x;
+			x = cic->integrators[s];
+		}
+
+		if (++cic->phase < cic->decimation)
+		{
+			continue;
+		}
+		cic->phase = 0;
+
+		for (int s = 0; s < cic->stages; s++)
+		{
+			uint64_t delayed = cic->combs[s][cic->delay - 1];
+			for (int d = cic->delay - 1; d > 0; d--)
+			{
+				cic->combs[s][d] = cic->combs[s][d - 1];
+			}
+			cic->combs[s][0] = x;
+			x -= delayed;
+		}
+		*(output + produced++) = (int64_t) x * cic->scale;
+	}
+
+	return produced;
+}
+
+void cic_free(struct CicDecimator *cic)
+{
+	free(cic);
+}
+
+struct MovingAverage *moving_average_create(int length)
+{
+	if (length < 1)
+	{
+		return NULL;
+	}
+
+	struct MovingAverage *average = calloc(1, sizeof(struct MovingAverage));
+	if (average == NULL)
+	{
+		return NULL;
+	}
+
+	average->length = length;
+	average->history = calloc(length, sizeof(int32_t));
+	if (average->history == NULL)
+	{
+		free(average);
+		return NULL;
+	}
+
+	return average;
+}
+
+/* Mean of the last length inputs, at a fixed cost per sample whatever the length. The running sum
+ * adds each new input and drops the oldest, exactly, as both are integers. */
+void moving_average_process(struct MovingAverage *average, const double *input, long count, double *output)
+{
+	double scale = 1.0 / (average->length * ldexp(1.0, CIC_FRACTION_BITS));
+
+	for (long n = 0; n < count; n++)
+	{
+		int32_t x = cic_quantise(*(input + n));
+
+		average->sum += (int64_t) x - *(average->history + average->index);
+		*(average->history + average->index) = x;
+		average->index = average->index + 1 < average->length ? average->index + 1 : 0;
+		*(output + n) = average->sum * scale;
+	}
+}
+
+void moving_average_free(struct MovingAverage *average)
+{
+	if (average != NULL)
+	{
+		free(average->history);
+		free(average);
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef CIC
+#define CIC
+
+/************************************************************************************************
+ * FilterTools/cic.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Cascaded integrator-comb decimators and recursive moving averages. Both run on
+ * 		  fixed point integer accumulators, so their running sums are exact and never drift.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <stdint.h>
+
+#define CIC_FRACTION_BITS 24	// Input samples are fixed point with this many fraction bits
+#define CIC_INPUT_BITS 32
+#define CIC_MAX_STAGES 8
+#define CIC_MAX_DELAY 2
+
+struct CicDecimator {
+	int stages;
+	int decimation;
+	int delay;		// Differential delay of each comb, 1 or 2
+	int phase;		// Inputs since the last output
+	uint64_t integrators[CIC_MAX_STAGES];
+	uint64_t combs[CIC_MAX_STAGES][CIC_MAX_DELAY];
+	double scale;		// Removes the (decimation * delay) ^ stages gain and the fixed point scale
+};
+
+struct MovingAverage {
+	int length;
+	int index;		// Oldest sample in history
+	int64_t sum;
+	int32_t *history;
+};
+
+int32_t cic_quantise(double x);
+
+struct CicDecimator *cic_create(int decimation, int stages, int delay);
+long cic_output_limit(const struct CicDecimator *cic, long count);
+long cic_process(struct CicDecimator *cic, const double *input, long count, double *output);
+void cic_free(struct CicDecimator *cic);
+
+struct MovingAverage *moving_average_create(int length);
+void moving_average_process(struct MovingAverage *average, const double *input, long count, double *output);
+void moving_average_free(struct MovingAverage *average);
+
+#endif
@@ -0,0 +1,964 @@
+/************************************************************************************************
+ * FilterTools/design.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: FIR and IIR filter design. Windowed sinc and Parks-McClellan FIR designs give
+ * 		  taps, Butterworth, Chebyshev and elliptic IIR designs give biquad sections
+ * 		  through the bilinear transform. Designs are memoised by their specification.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "design.h"
+#include "../../DFT/src/window.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <complex.h>
+
+#define LANDEN_MAX 20
+#define ROOT_TOLERANCE 1e-10
+
+static struct FilterDesign *design_cache[DESIGN_CACHE_BUCKETS];
+
+// Roots and gain of a transfer function, analog or digital.
+struct Zpk {
+	double complex *zeros;
+	int zero_count;
+	double complex *poles;
+	int pole_count;
+	double gain;
+};
+
+/************************************************************************************************
+ * FIR designs
+ ************************************************************************************************ */
+
+// Ideal lowpass impulse response at offset x from the centre, cutoff in cycles per sample.
+static double ideal_lowpass(double cutoff, double x)
+{
+	return x == 0.0 ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * x) / (M_PI * x);
+}
+
+// Magnitude of the response of taps at frequency f in cycles per sample.
+static double fir_gain(const double *taps, int count, double f)
+{
+	double complex sum = 0.0;
+	for (int n = 0; n < count; n++)
+	{
+		sum += *(taps + n) * cexp(-2.0 * M_PI * I * f * n);
+	}
+	return cabs(sum);
+}
+
+// Hamming windowed ideal response, normalised to unit gain at the centre of the passband.
+static int windowed_sinc(const struct FilterSpec *spec, int count, double *taps)
+{
+	const struct Window *window = window_get(HAMMING, count, 1, 0.0);
+	if (window == NULL)
+	{
+		return 0;
+	}
+
+	double f1 = spec->edges[0] / spec->sample_rate;
+	double f2 = spec->edges[1] / spec->sample_rate;
+	double centre = (count - 1) / 2.0;
+
+	for (int n = 0; n < count; n++)
+	{
+		double x = n - centre;
+		double impulse = x == 0.0 ? 1.0 : 0.0;
+		double h = 0.0;
+
+		switch (spec->band)
+		{
+			case LOWPASS :
+				h = ideal_lowpass(f1, x);
+				break;
+			case HIGHPASS :
+				h = impulse - ideal_lowpass(f1, x);
+				break;
+			case BANDPASS :
+				h = ideal_lowpass(f2, x) - ideal_lowpass(f1, x);
+				break;
+			case BANDSTOP :
+				h = impulse - ideal_lowpass(f2, x) + ideal_lowpass(f1, x);
+				break;
+		}
+		*(taps + n) = h * *(window->values + n);
+	}
+
+	double reference = spec->band == HIGHPASS ? 0.5 : spec->band == BANDPASS ? (f1 + f2) / 2.0 : 0.0;
+	double gain = fir_gain(taps, count, reference);
+	for (int n = 0; gain > 0.0 && n < count; n++)
+	{
+		*(taps + n) /= gain;
+	}
+	return 1;
+}
+
+/* Barycentric weights of the extremal abscissae. Products of up to a few hundred differences
+ * overflow, so each weight is formed in the log domain and all are scaled by the largest. The
+ * scale cancels in every use. */
+static void barycentric_weights(const double *x, int count, double *weights)
+{
+	double largest = -INFINITY;
+
+	for (int i = 0; i < count; i++)
+	{
+		double log_magnitude = 0.0;
+		int negative = 0;
+		for (int j = 0; j < count; j++)
+		{
+			if (j != i)
+			{
+				double difference = *(x + i) - *(x + j);
+				difference = fabs(difference) < 1e-300 ? 1e-300 : difference;
+				log_magnitude -= log(fabs(difference));
+				negative ^= difference < 0.0;
+			}
+		}
+		*(weights + i) = negative ? -log_magnitude : log_magnitude;
+		largest = log_magnitude > largest ? log_magnitude : largest;
+	}
+	for (int i = 0; i < count; i++)
+	{
+		double log_magnitude = fabs(*(weights + i));
+		double sign = *(weights + i) < 0.0 ? -1.0 : 1.0;
+		*(weights + i) = sign * exp(log_magnitude - largest);
+	}
+}
+
+// Amplitude response at cos(2 pi f) = xc, interpolated through the extremal values.
+static double remez_amplitude(double xc, const double *x, const double *y, const double *weights, int count)
+{
+	double numerator = 0.0;
+	double denominator = 0.0;
+
+	for (int i = 0; i < count; i++)
+	{
+		double c = xc - *(x + i);
+		if (fabs(c) < 1e-12)
+		{
+			return *(y + i);
+		}
+		c = *(weights + i) / c;
+		numerator += c * *(y + i);
+		denominator += c;
+	}
+	return numerator / denominator;
+}
+
+/* Picks the next r + 1 extremal grid points from the error. Local extrema are collected, runs of
+ * the same sign are reduced to their largest member, then the smaller end is dropped until r + 1
+ * alternating extrema remain. Returns 0 if too few alternations were found. */
+static int remez_search(const double *error, int grid_size, int *extremals, int needed, int *found)
+{
+	int count = 0;
+
+	for (int i = 0; i < grid_size; i++)
+	{
+		double e = *(error + i);
+		double before = i > 0 ? *(error + i - 1) : -e;
+		double after = i < grid_size - 1 ? *(error + i + 1) : -e;
+
+		if ((e > 0.0 && e >= before && e > after) || (e < 0.0 && e <= before && e < after))
+		{
+			if (count > 0 && (*(error + *(found + count - 1)) > 0.0) == (e > 0.0))
+			{
+				if (fabs(e) > fabs(*(error + *(found + count - 1))))
+				{
+					*(found + count - 1) = i;
+				}
+			}
+			else
+			{
+				*(found + count++) = i;
+			}
+		}
+	}
+
+	if (count < needed)
+	{
+		return 0;
+	}
+
+	int first = 0;
+	while (count - first > needed)
+	{
+		if (fabs(*(error + *(found + first))) < fabs(*(error + *(found + count - 1))))
+		{
+			first++;
+		}
+		else
+		{
+			count--;
+		}
+	}
+	memcpy(extremals, found + first, needed * sizeof(int));
+	return 1;
+}
+
+/* Parks-McClellan equiripple design of an odd length, even symmetric filter by Remez exchange.
+ * Bands are edge pairs in cycles per sample, each with a desired gain and error weight. */
+static int remez(int count, const double *bands, const double *desired, const double *weights, int band_count, double *taps)
+{
+	int r = (count - 1) / 2 + 1;	// Cosine terms, r + 1 extremals alternate
+	double spacing = 0.5 / (REMEZ_GRID_DENSITY * r);
+	int grid_limit = 2 * REMEZ_GRID_DENSITY * r + 2 * band_count + r + 2;
+
+	double *grid = malloc(grid_limit * sizeof(double));
+	double *grid_desired = malloc(grid_limit * sizeof(double));
+	double *grid_weight = malloc(grid_limit * sizeof(double));
+	double *error = malloc(grid_limit * sizeof(double));
+	int *found = malloc(grid_limit * sizeof(int));
+	int *extremals = malloc((r + 1) * sizeof(int));
+	double *x = malloc((r + 1) * sizeof(double));
+	double *y = malloc((r + 1) * sizeof(double));
+	double *ad = malloc((r + 1) * sizeof(double));
+	int status = grid != NULL && grid_desired != NULL && grid_weight != NULL && error != NULL && found != NULL && extremals != NULL && x != NULL && y != NULL && ad != NULL;
+
+	// Dense grid across every band, each band including both of its edges.
+	int grid_size = 0;
+	for (int b = 0; status && b < band_count; b++)
+	{
+		double low = *(bands + 2 * b);
+		double high = *(bands + 2 * b + 1);
+		int points = (int) ((high - low) / spacing + 0.5);
+		points = points < 1 ? 1 : points;
+
+		for (int i = 0; i <= points && grid_size < grid_limit; i++)
+		{
+			*(grid + grid_size) = low + (high - low) * i / points;
+			*(grid_desired + grid_size) = *(desired + b);
+			*(grid_weight + grid_size) = *(weights + b);
+			grid_size++;
+		}
+	}
+	status = status && grid_size > r + 1;
+
+	for (int i = 0; status && i <= r; i++)
+	{
+		*(extremals + i) = (int) ((long) i * (grid_size - 1) / r);
+	}
+
+	for (int iteration = 0; status && iteration < REMEZ_MAX_ITERATIONS; iteration++)
+	{
+		for (int i = 0; i <= r; i++)
+		{
+			*(x + i) = cos(2.0 * M_PI * *(grid + *(extremals + i)));
+		}
+		barycentric_weights(x, r + 1, ad);
+
+		double numerator = 0.0;
+		double denominator = 0.0;
+		for (int i = 0; i <= r; i++)
+		{
+			double sign = i % 2 == 0 ? 1.0 : -1.0;
+			numerator += *(ad + i) * *(grid_desired + *(extremals + i));
+			denominator += sign * *(ad + i) / *(grid_weight + *(extremals + i));
+		}
+		double delta = numerator / denominator;
+		for (int i = 0; i <= r; i++)
+		{
+			double sign = i % 2 == 0 ? 1.0 : -1.0;
+			*(y + i) = *(grid_desired + *(extremals + i)) - sign * delta / *(grid_weight + *(extremals + i));
+		}
+
+		for (int i = 0; i < grid_size; i++)
+		{
+			double amplitude = remez_amplitude(cos(2.0 * M_PI * *(grid + i)), x, y, ad, r + 1);
+			*(error + i) = *(grid_weight + i) * (*(grid_desired + i) - amplitude);
+		}
+
+		if (!remez_search(error, grid_size, extremals, r + 1, found))
+		{
+			break;
+		}
+
+		// Converged once every extremal error has the same magnitude.
+		double smallest = INFINITY;
+		double largest = 0.0;
+		for (int i = 0; i <= r; i++)
+		{
+			double e = fabs(*(error + *(extremals + i)));
+			smallest = e < smallest ? e : smallest;
+			largest = e > largest ? e : largest;
+		}
+		if (largest - smallest <= 1e-6 * largest)
+		{
+			break;
+		}
+	}
+
+	// Taps from the amplitude response sampled at count equally spaced frequencies.
+	if (status)
+	{
+		for (int i = 0; i <= r; i++)
+		{
+			*(x + i) = cos(2.0 * M_PI * *(grid + *(extremals + i)));
+		}
+		int half = (count - 1) / 2;
+		double *amplitude = error;	// Reused, count <= grid size
+		for (int k = 0; k <= half; k++)
+		{
+			*(amplitude + k) = remez_amplitude(cos(2.0 * M_PI * k / count), x, y, ad, r + 1);
+		}
+		for (int n = 0; n < count; n++)
+		{
+			double sum = *amplitude;
+			for (int k = 1; k <= half; k++)
+			{
+				sum += 2.0 * *(amplitude + k) * cos(2.0 * M_PI * k * (n - half) / count);
+			}
+			*(taps + n) = sum / count;
+		}
+	}
+
+	free(grid);
+	free(grid_desired);
+	free(grid_weight);
+	free(error);
+	free(found);
+	free(extremals);
+	free(x);
+	free(y);
+	free(ad);
+	return status;
+}
+
+// Bands for an equiripple design, transition regions centred on the specified edges.
+static int equiripple(const struct FilterSpec *spec, int count, double *taps)
+{
+	double half_width = spec->transition / (2.0 * spec->sample_rate);
+	double f1 = spec->edges[0] / spec->sample_rate;
+	double f2 = spec->edges[1] / spec->sample_rate;
+	double bands[6];
+	double desired[3];
+	double weights[3];
+	int band_count = 0;
+
+	// Stopband weight trades the two ripples, their ratio is set from the dB specifications.
+	double pass_ripple = spec->ripple > 0.0 ? (pow(10.0, spec->ripple / 20.0) - 1.0) / (pow(10.0, spec->ripple / 20.0) + 1.0) : 1.0;
+	double stop_ripple = spec->attenuation > 0.0 ? pow(10.0, -spec->attenuation / 20.0) : 1.0;
+	double stop_weight = spec->ripple > 0.0 && spec->attenuation > 0.0 ? pass_ripple / stop_ripple : 1.0;
+
+	double edges[4] = { f1 - half_width, f1 + half_width, f2 - half_width, f2 + half_width };
+	int pass_first = spec->band == HIGHPASS || spec->band == BANDPASS ? 0 : 1;
+	int edge_count = spec->band == LOWPASS || spec->band == HIGHPASS ? 2 : 4;
+
+	double low = 0.0;
+	for (int e = 0; e <= edge_count; e += 2)
+	{
+		double high = e < edge_count ? edges[e] : 0.5;
+		int pass = (e / 2) % 2 == 0 ? pass_first : !pass_first;
+
+		if (high <= low || low < 0.0 || high > 0.5)
+		{
+			return 0;
+		}
+		bands[2 * band_count] = low;
+		bands[2 * band_count + 1] = high;
+		desired[band_count] = pass;
+		weights[band_count] = pass ? 1.0 : stop_weight;
+		band_count++;
+		low = e < edge_count ? edges[e + 1] : 0.5;
+	}
+
+	return remez(count, bands, desired, weights, band_count, taps);
+}
+
+/************************************************************************************************
+ * IIR designs
+ ************************************************************************************************ */
+
+// Descending moduli of the Landen transformation of k, which approach zero quadratically.
+static int landen(double k, double *v)
+{
+	int count = 0;
+	while (k > 1e-15 && count < LANDEN_MAX)
+	{
+		k = pow(k / (1.0 + sqrt(1.0 - k * k)), 2.0);
+		*(v + count++) = k;
+	}
+	return count;
+}
+
+// Jacobi cd(uK, k), u complex and in units of the quarter period K.
+static double complex cde(double complex u, double k)
+{
+	double v[LANDEN_MAX];
+	int count = landen(k, v);
+	double complex w = ccos(u * M_PI / 2.0);
+
+	for (int i = count - 1; i >= 0; i--)
+	{
+		w = (1.0 + v[i]) * w / (1.0 + v[i] * w * w);
+	}
+	return w;
+}
+
+// Jacobi sn(uK, k)
+static double complex sne(double complex u, double k)
+{
+	double v[LANDEN_MAX];
+	int count = landen(k, v);
+	double complex w = csin(u * M_PI / 2.0);
+
+	for (int i = count - 1; i >= 0; i--)
+	{
+		w = (1.0 + v[i]) * w / (1.0 + v[i] * w * w);
+	}
+	return w;
+}
+
+// Inverse of sne(), u in units of K.
+static double complex asne(double complex w, double k)
+{
+	double v[LANDEN_MAX];
+	int count = landen(k, v);
+
+	for (int i = 0; i < count; i++)
+	{
+		double previous = i == 0 ? k : v[i - 1];
+		w = w / (1.0 + csqrt(1.0 - w * w * previous * previous)) * 2.0 / (1.0 + v[i]);
+	}
+	return 2.0 / M_PI * casin(w);
+}
+
+// Selectivity modulus of an order N elliptic filter with discrimination modulus k1.
+static double elliptic_degree(int order, double k1)
+{
+	double k1_complement = sqrt(1.0 - k1 * k1);
+	double k_complement = pow(k1_complement, order);
+
+	for (int i = 1; i <= order / 2; i++)
+	{
+		k_complement *= pow(creal(sne((2.0 * i - 1.0) / order, k1_complement)), 4.0);
+	}
+	return sqrt(1.0 - k_complement * k_complement);
+}
+
+/* Analog lowpass prototypes with unit cutoff. Butterworth is -3 dB at the cutoff, Chebyshev and
+ * elliptic designs are at the edge of their passband ripple. Elliptic designs follow Orfanidis,
+ * evaluating the Jacobi functions by Landen transformations. */
+static void analog_prototype(const struct FilterSpec *spec, struct Zpk *zpk)
+{
+	int order = spec->order;
+	double epsilon = sqrt(pow(10.0, spec->ripple / 10.0) - 1.0);
+
+	zpk->zero_count = 0;
+	zpk->pole_count = order;
+	zpk->gain = 1.0;
+
+	if (spec->method == BUTTERWORTH)
+	{
+		for (int k = 0; k < order; k++)
+		{
+			*(zpk->poles + k) = cexp(I * M_PI * (2.0 * k + order + 1.0) / (2.0 * order));
+		}
+	}
+	else if (spec->method == CHEBYSHEV)
+	{
+		double mu = asinh(1.0 / epsilon) / order;
+		for (int k = 0; k < order; k++)
+		{
+			double theta = M_PI * (2.0 * k + 1.0) / (2.0 * order);
+			*(zpk->poles + k) = -sinh(mu) * sin(theta) + I * cosh(mu) * cos(theta);
+		}
+	}
+	else
+	{
+		double k1 = epsilon / sqrt(pow(10.0, spec->attenuation / 10.0) - 1.0);
+		double k = elliptic_degree(order, k1);
+		double v0 = creal(-I * asne(I / epsilon, k1) / order);
+		int p = 0;
+
+		for (int i = 1; i <= order / 2; i++)
+		{
+			double u = (2.0 * i - 1.0) / order;
+			double complex zero = I / (k * cde(u, k));
+			double complex pole = I * cde(u - I * v0, k);
+
+			*(zpk->zeros + zpk->zero_count++) = zero;
+			*(zpk->zeros + zpk->zero_count++) = conj(zero);
+			*(zpk->poles + p++) = pole;
+			*(zpk->poles + p++) = conj(pole);
+		}
+		if (order % 2 == 1)
+		{
+			*(zpk->poles + p++) = I * sne(I * v0, k);
+		}
+	}
+
+	// Unit gain at DC, or the bottom of the ripple for even order ripple designs.
+	double complex gain = 1.0;
+	for (int i = 0; i < zpk->pole_count; i++)
+	{
+		gain *= -*(zpk->poles + i);
+	}
+	for (int i = 0; i < zpk->zero_count; i++)
+	{
+		gain /= -*(zpk->zeros + i);
+	}
+	zpk->gain = creal(gain);
+	if (spec->method != BUTTERWORTH && order % 2 == 0)
+	{
+		zpk->gain /= sqrt(1.0 + epsilon * epsilon);
+	}
+}
+
+static double complex root_product(const double complex *roots, int count, double complex shift)
+{
+	double complex product = 1.0;
+	for (int i = 0; i < count; i++)
+	{
+		product *= shift - *(roots + i);
+	}
+	return product;
+}
+
+// Maps each root r of the prototype to the two roots of s^2 - a s + w0^2 = 0 around a = scale(r).
+static void split_roots(double complex *roots, int count, double w0, double bandwidth, int reciprocal)
+{
+	for (int i = count - 1; i >= 0; i--)
+	{
+		double complex a = reciprocal ? bandwidth / 2.0 / *(roots + i) : *(roots + i) * bandwidth / 2.0;
+		double complex root = csqrt(a * a - w0 * w0);
+		*(roots + 2 * i) = a + root;
+		*(roots + 2 * i + 1) = a - root;
+	}
+}
+
+// Moves the unit cutoff prototype to the prewarped band edges of the specification.
+static void analog_transform(const struct FilterSpec *spec, struct Zpk *zpk)
+{
+	double w1 = 2.0 * spec->sample_rate * tan(M_PI * spec->edges[0] / spec->sample_rate);
+	double w2 = 2.0 * spec->sample_rate * tan(M_PI * spec->edges[1] / spec->sample_rate);
+	double w0 = sqrt(w1 * w2);
+	double bandwidth = w2 - w1;
+	int degree = zpk->pole_count - zpk->zero_count;
+
+	switch (spec->band)
+	{
+		case LOWPASS :
+			for (int i = 0; i < zpk->zero_count; i++)
+			{
+				*(zpk->zeros + i) *= w1;
+			}
+			for (int i = 0; i < zpk->pole_count; i++)
+			{
+				*(zpk->poles + i) *= w1;
+			}
+			zpk->gain *= pow(w1, degree);
+			break;
+		case HIGHPASS :
+			zpk->gain *= creal(root_product(zpk->zeros, zpk->zero_count, 0.0) / root_product(zpk->poles, zpk->pole_count, 0.0));
+			for (int i = 0; i < zpk->zero_count; i++)
+			{
+				*(zpk->zeros + i) = w1 / *(zpk->zeros + i);
+			}
+			for (int i = 0; i < zpk->pole_count; i++)
+			{
+				*(zpk->poles + i) = w1 / *(zpk->poles + i);
+			}
+			for (int i = 0; i < degree; i++)
+			{
+				*(zpk->zeros + zpk->zero_count++) = 0.0;
+			}
+			break;
+		case BANDPASS :
+			split_roots(zpk->zeros, zpk->zero_count, w0, bandwidth, 0);
+			split_roots(zpk->poles, zpk->pole_count, w0, bandwidth, 0);
+			zpk->zero_count *= 2;
+			zpk->pole_count *= 2;
+			for (int i = 0; i < degree; i++)
+			{
+				*(zpk->zeros + zpk->zero_count++) = 0.0;
+			}
+			zpk->gain *= pow(bandwidth, degree);
+			break;
+		case BANDSTOP :
+			zpk->gain *= creal(root_product(zpk->zeros, zpk->zero_count, 0.0) / root_product(zpk->poles, zpk->pole_count, 0.0));
+			split_roots(zpk->zeros, zpk->zero_count, w0, bandwidth, 1);
+			split_roots(zpk->poles, zpk->pole_count, w0, bandwidth, 1);
+			zpk->zero_count *= 2;
+			zpk->pole_count *= 2;
+			for (int i = 0; i < degree; i++)
+			{
+				*(zpk->zeros + zpk->zero_count++) = I * w0;
+				*(zpk->zeros + zpk->zero_count++) = -I * w0;
+			}
+			break;
+	}
+}
+
+// Bilinear transform, zeros at infinity map to z = -1.
+static void bilinear(const struct FilterSpec *spec, struct Zpk *zpk)
+{
+	double fs2 = 2.0 * spec->sample_rate;
+
+	zpk->gain *= creal(root_product(zpk->zeros, zpk->zero_count, fs2) / root_product(zpk->poles, zpk->pole_count, fs2));
+	for (int i = 0; i < zpk->zero_count; i++)
+	{
+		*(zpk->zeros + i) = (fs2 + *(zpk->zeros + i)) / (fs2 - *(zpk->zeros + i));
+	}
+	for (int i = 0; i < zpk->pole_count; i++)
+	{
+		*(zpk->poles + i) = (fs2 + *(zpk->poles + i)) / (fs2 - *(zpk->poles + i));
+	}
+	while (zpk->zero_count < zpk->pole_count)
+	{
+		*(zpk->zeros + zpk->zero_count++) = -1.0;
+	}
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+	double x = *(const double *) a;
+	double y = *(const double *) b;
+	return (x > y) - (x < y);
+}
+
+/* Groups roots into quadratics 1 + c1 z^-1 + c2 z^-2, conjugate pairs together and real roots in
+ * sorted pairs. A leftover real root gives a first order term. Each quadratic keeps one of its
+ * roots for pairing poles with zeros. Returns the number of quadratics. */
+static int quadratics(const double complex *roots, int count, double *terms, double complex *representative)
+{
+	int *used = calloc(count, sizeof(int));
+	double *reals = malloc(count * sizeof(double));
+	int quadratic_count = 0;
+	int real_count = 0;
+
+	for (int i = 0; used != NULL && reals != NULL && i < count; i++)
+	{
+		double complex root = *(roots + i);
+		if (*(used + i))
+		{
+			continue;
+		}
+		if (fabs(cimag(root)) <= ROOT_TOLERANCE * fmax(1.0, cabs(root)))
+		{
+			*(reals + real_count++) = creal(root);
+			continue;
+		}
+
+		int match = -1;
+		for (int j = i + 1; j < count; j++)
+		{
+			if (!*(used + j) && (match < 0 || cabs(*(roots + j) - conj(root)) < cabs(*(roots + match) - conj(root))))
+			{
+				match = j;
+			}
+		}
+		if (match >= 0)
+		{
+			*(used + match) = 1;
+		}
+		*(terms + 2 * quadratic_count) = -2.0 * creal(root);
+		*(terms + 2 * quadratic_count + 1) = creal(root * conj(root));
+		*(representative + quadratic_count++) = cimag(root) > 0.0 ? root : conj(root);
+	}
+
+	qsort(reals, real_count, sizeof(double), &compare_doubles);
+	for (int i = 0; reals != NULL && i < real_count; i += 2)
+	{
+		double a = *(reals + i);
+		double b = i + 1 < real_count ? *(reals + i + 1) : 0.0;
+		*(terms + 2 * quadratic_count) = i + 1 < real_count ? -(a + b) : -a;
+		*(terms + 2 * quadratic_count + 1) = a * b;
+		*(representative + quadratic_count++) = fabs(a) > fabs(b) ? a : b;
+	}
+
+	free(used);
+	free(reals);
+	return quadratic_count;
+}
+
+/* Second order sections, ordered from the pole pair furthest from the unit circle. Working from
+ * the pole pair nearest the unit circle, each takes the closest remaining zero pair. Each section
+ * is scaled to unit gain at the reference frequency, in radians per sample, and what remains of
+ * the overall gain is shared equally, so no section's numerator is tiny while another's is huge.
+ * Returns the section count, 0 on failure. */
+static int zpk_to_sections(const struct Zpk *zpk, double reference, double **coefficients)
+{
+	int limit = zpk->pole_count + zpk->zero_count;
+	double *pole_terms = malloc(2 * limit * sizeof(double));
+	double *zero_terms = malloc(2 * limit * sizeof(double));
+	double complex *pole_roots = malloc(limit * sizeof(double complex));
+	double complex *zero_roots = malloc(limit * sizeof(double complex));
+	int *taken = calloc(limit, sizeof(int));
+	int *order = malloc(limit * sizeof(int));
+	double *magnitudes = malloc(limit * sizeof(double));
+	int sections = 0;
+
+	if (pole_terms != NULL && zero_terms != NULL && pole_roots != NULL && zero_roots != NULL && taken != NULL && order != NULL && magnitudes != NULL)
+	{
+		sections = quadratics(zpk->poles, zpk->pole_count, pole_terms, pole_roots);
+		int zero_sections = quadratics(zpk->zeros, zpk->zero_count, zero_terms, zero_roots);
+		for (int i = zero_sections; i < sections; i++)
+		{
+			*(zero_terms + 2 * i) = 0.0;
+			*(zero_terms + 2 * i + 1) = 0.0;
+			*(zero_roots + i) = 0.0;
+		}
+		zero_sections = sections > zero_sections ? sections : zero_sections;
+
+		// Insertion sort of pole pairs by distance from the origin.
+		for (int i = 0; i < sections; i++)
+		{
+			int j = i;
+			while (j > 0 && cabs(*(pole_roots + *(order + j - 1))) > cabs(*(pole_roots + i)))
+			{
+				*(order + j) = *(order + j - 1);
+				j--;
+			}
+			*(order + j) = i;
+		}
+
+		*coefficients = malloc(6 * sections * sizeof(double));
+		for (int s = sections - 1; *coefficients != NULL && s >= 0; s--)
+		{
+			int pole = *(order + s);
+			int zero = -1;
+			for (int z = 0; z < zero_sections; z++)
+			{
+				if (!*(taken + z) && (zero < 0 || cabs(*(zero_roots + z) - *(pole_roots + pole)) < cabs(*(zero_roots + zero) - *(pole_roots + pole))))
+				{
+					zero = z;
+				}
+			}
+			*(taken + zero) = 1;
+
+			double *section = *coefficients + 6 * s;
+			*(section + 0) = 1.0;
+			*(section + 1) = *(zero_terms + 2 * zero);
+			*(section + 2) = *(zero_terms + 2 * zero + 1);
+			*(section + 3) = 1.0;
+			*(section + 4) = *(pole_terms + 2 * pole);
+			*(section + 5) = *(pole_terms + 2 * pole + 1);
+		}
+		sections = *coefficients != NULL ? sections : 0;
+
+		// A section with a zero at the reference is taken as unit gain there.
+		double complex delay = cexp(-I * reference);
+		double remaining = zpk->gain;
+		for (int s = 0; s < sections; s++)
+		{
+			double *section = *coefficients + 6 * s;
+			double complex numerator = 1.0 + delay * (*(section + 1) + delay * *(section + 2));
+			double complex denominator = 1.0 + delay * (*(section + 4) + delay * *(section + 5));
+			double magnitude = cabs(numerator / denominator);
+
+			*(magnitudes + s) = isnormal(magnitude) ? magnitude : 1.0;
+			remaining *= *(magnitudes + s);
+		}
+		double share = sections > 0 ? pow(fabs(remaining), 1.0 / sections) : 1.0;
+		for (int s = 0; s < sections; s++)
+		{
+			double gain = share / *(magnitudes + s) * (s == 0 && remaining < 0.0 ? -1.0 : 1.0);
+			for (int k = 0; k < 3; k++)
+			{
+				*(*coefficients + 6 * s + k) *= gain;
+			}
+		}
+	}
+
+	free(pole_terms);
+	free(zero_terms);
+	free(pole_roots);
+	free(zero_roots);
+	free(taken);
+	free(order);
+	free(magnitudes);
+	return sections;
+}
+
+/* A frequency inside the passband, in radians per sample, where section gains are normalised.
+ * The bilinear transform maps the geometric centre of the prewarped band edges to the peak of a
+ * bandpass design. */
+static double passband_reference(const struct FilterSpec *spec)
+{
+	switch (spec->band)
+	{
+		case HIGHPASS :
+			return M_PI;
+		case BANDPASS :
+			return 2.0 * atan(sqrt(tan(M_PI * spec->edges[0] / spec->sample_rate) * tan(M_PI * spec->edges[1] / spec->sample_rate)));
+		default :
+			return 0.0;
+	}
+}
+
+static int iir_design(const struct FilterSpec *spec, double **coefficients)
+{
+	struct Zpk zpk;
+	int limit = 4 * spec->order;
+
+	zpk.zeros = malloc(limit * sizeof(double complex));
+	zpk.poles = malloc(limit * sizeof(double complex));
+	int sections = 0;
+
+	if (zpk.zeros != NULL && zpk.poles != NULL)
+	{
+		analog_prototype(spec, &zpk);
+		analog_transform(spec, &zpk);
+		bilinear(spec, &zpk);
+		sections = zpk_to_sections(&zpk, passband_reference(spec), coefficients);
+	}
+
+	free(zpk.zeros);
+	free(zpk.poles);
+	return sections;
+}
+
+/************************************************************************************************
+ * Memoisation
+ ************************************************************************************************ */
+
+// Clears the fields a method ignores so equivalent specifications share one cache entry.
+static struct FilterSpec canonical_spec(const struct FilterSpec *spec)
+{
+	struct FilterSpec key;
+	memset(&key, 0, sizeof(key));
+
+	int fir = spec->method == WINDOWED_SINC || spec->method == EQUIRIPPLE;
+	int band = spec->band == BANDPASS || spec->band == BANDSTOP;
+
+	key.method = spec->method;
+	key.band = spec->band;
+	key.order = spec->order;
+	// Highpass and bandstop FIR designs need a centre tap, so lengths are made odd.
+	if (fir && (spec->method == EQUIRIPPLE || spec->band == HIGHPASS || spec->band == BANDSTOP) && key.order % 2 == 0)
+	{
+		key.order++;
+	}
+	key.sample_rate = spec->sample_rate;
+	key.edges[0] = spec->edges[0];
+	key.edges[1] = band ? spec->edges[1] : 0.0;
+	key.transition = spec->method == EQUIRIPPLE ? spec->transition : 0.0;
+	key.ripple = spec->method == CHEBYSHEV || spec->method == ELLIPTIC || spec->method == EQUIRIPPLE ? spec->ripple : 0.0;
+	key.attenuation = spec->method == ELLIPTIC || spec->method == EQUIRIPPLE ? spec->attenuation : 0.0;
+
+	return key;
+}
+
+static int spec_equal(const struct FilterSpec *a, const struct FilterSpec *b)
+{
+	return a->method == b->method && a->band == b->band && a->order == b->order && a->sample_rate == b->sample_rate && a->edges[0] == b->edges[0] && a->edges[1] == b->edges[1] && a->transition == b->transition && a->ripple == b->ripple && a->attenuation == b->attenuation;
+}
+
+static uint64_t hash_value(uint64_t hash, const void *value, size_t size)
+{
+	const unsigned char *bytes = value;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash = (hash ^ *(bytes + i)) * 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+// FNV-1a over each field, so structure padding never contributes.
+static unsigned int spec_hash(const struct FilterSpec *spec)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	int fields[] = { spec->method, spec->band, spec->order };
+	double values[] = { spec->sample_rate, spec->edges[0], spec->edges[1], spec->transition, spec->ripple, spec->attenuation };
+
+	hash = hash_value(hash, fields, sizeof(fields));
+	hash = hash_value(hash, values, sizeof(values));
+	return hash % DESIGN_CACHE_BUCKETS;
+}
+
+static int valid_spec(const struct FilterSpec *spec)
+{
+	int band = spec->band == BANDPASS || spec->band == BANDSTOP;
+	int iir = spec->method == BUTTERWORTH || spec->method == CHEBYSHEV || spec->method == ELLIPTIC;
+
+	return spec->order > 0 && spec->sample_rate > 0.0 && spec->edges[0] > 0.0 && spec->edges[0] < spec->sample_rate / 2.0
+		&& (!band || (spec->edges[1] > spec->edges[0] && spec->edges[1] < spec->sample_rate / 2.0))
+		&& (spec->method != EQUIRIPPLE || spec->transition > 0.0)
+		&& (spec->method != CHEBYSHEV || spec->ripple > 0.0)
+		&& (spec->method != ELLIPTIC || (spec->ripple > 0.0 && spec->attenuation > spec->ripple))
+		&& (!iir || spec->order <= 64);
+}
+
+/* Returns the design for a specification, computing it on first request. Designs stay owned by
+ * the cache until filter_design_clear_cache(). Returns NULL for an invalid specification. */
+const struct FilterDesign *filter_design(const struct FilterSpec *spec)
+{
+	if (!valid_spec(spec))
+	{
+		return NULL;
+	}
+
+	struct FilterSpec key = canonical_spec(spec);
+	unsigned int bucket = spec_hash(&key);
+	for (struct FilterDesign *design = design_cache[bucket]; design != NULL; design = design->next)
+	{
+		if (spec_equal(&design->spec, &key))
+		{
+			return design;
+		}
+	}
+
+	struct FilterDesign *design = calloc(1, sizeof(struct FilterDesign));
+	if (design == NULL)
+	{
+		return NULL;
+	}
+	design->spec = key;
+	design->fir = key.method == WINDOWED_SINC || key.method == EQUIRIPPLE;
+
+	int status = 0;
+	if (design->fir)
+	{
+		design->count = key.order;
+		design->coefficients = malloc(key.order * sizeof(double));
+		if (design->coefficients != NULL && key.method == WINDOWED_SINC)
+		{
+			status = windowed_sinc(&key, key.order, design->coefficients);
+		}
+		else if (design->coefficients != NULL)
+		{
+			status = equiripple(&key, key.order, design->coefficients);
+		}
+	}
+	else
+	{
+		design->count = iir_design(&key, &design->coefficients);
+		status = design->count > 0;
+	}
+
+	if (!status)
+	{
+		free(design->coefficients);
+		free(design);
+		return NULL;
+	}
+
+	design->next = design_cache[bucket];
+	design_cache[bucket] = design;
+	return design;
+}
+
+void filter_design_clear_cache(void)
+{
+	for (int bucket = 0; bucket < DESIGN_CACHE_BUCKETS; bucket++)
+	{
+		while (design_cache[bucket] != NULL)
+		{
+			struct FilterDesign *next = design_cache[bucket]->next;
+			free(design_cache[bucket]->coefficients);
+			free(design_cache[bucket]);
+			design_cache[bucket] = next;
+		}
+	}
+}
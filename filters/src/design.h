@@ -0,0 +1,52 @@
+#ifndef DESIGN
+#define DESIGN
+
+/************************************************************************************************
+ * FilterTools/design.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: FIR and IIR filter design. Windowed sinc and Parks-McClellan FIR designs give
+ * 		  taps, Butterworth, Chebyshev and elliptic IIR designs give biquad sections
+ * 		  through the bilinear transform. Designs are memoised by their specification.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#define DESIGN_METHOD_NAMES { "sinc", "remez", "butterworth", "chebyshev", "elliptic" }
+#define DESIGN_BAND_NAMES { "lowpass", "highpass", "bandpass", "bandstop" }
+
+#define REMEZ_GRID_DENSITY 16
+#define REMEZ_MAX_ITERATIONS 40
+#define DESIGN_CACHE_BUCKETS 64
+
+enum DesignMethod { WINDOWED_SINC, EQUIRIPPLE, BUTTERWORTH, CHEBYSHEV, ELLIPTIC };
+enum FilterBand { LOWPASS, HIGHPASS, BANDPASS, BANDSTOP };
+
+struct FilterSpec {
+	enum DesignMethod method;
+	enum FilterBand band;
+	int order;		// Taps for FIR methods, prototype order for IIR methods
+	double sample_rate;	// Hz
+	double edges[2];	// Cutoff in Hz, second edge for band types only
+	double transition;	// Hz, equiripple transition width centred on each edge
+	double ripple;		// dB, passband ripple for Chebyshev, elliptic and equiripple
+	double attenuation;	// dB, stopband attenuation for elliptic and equiripple
+};
+
+struct FilterDesign {
+	struct FilterSpec spec;
+	int fir;		// Coefficients are taps, otherwise biquad sections
+	int count;		// Taps or sections
+	double *coefficients;	// Sections are six values, b0 b1 b2 a0 a1 a2
+	struct FilterDesign *next;	// Cache chain
+};
+
+const struct FilterDesign *filter_design(const struct FilterSpec *spec);
+void filter_design_clear_cache(void);
+
+#endif
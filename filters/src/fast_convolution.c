@@ -0,0 +1,198 @@
+/************************************************************************************************
+ * FilterTools/fast_convolution.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Uniformly partitioned overlap-save convolution for long FIR filters, and a
+ * 		  convolver choosing between it and direct form at a fixed crossover.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "fast_convolution.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Partition sizes default to the tap count rounded up to a power of 2, which minimises work per
+ * sample. A smaller partition lowers the work done when a block completes at the cost of more
+ * partitions to accumulate. */
+struct FastConvolver *fast_convolver_create(const double *taps, int tap_count, int partition)
+{
+	if (tap_count < 1)
+	{
+		return NULL;
+	}
+
+	partition = fft_next_power_of_2(partition > 0 ? partition : tap_count);
+	partition = partition < FAST_PARTITION_MIN ? FAST_PARTITION_MIN : partition;
+	partition = partition > FAST_PARTITION_MAX ? FAST_PARTITION_MAX : partition;
+
+	struct FastConvolver *fast = calloc(1, sizeof(struct FastConvolver));
+	if (fast == NULL)
+	{
+		return NULL;
+	}
+
+	int size = 2 * partition;
+	fast->partition = partition;
+	fast->partition_count = (tap_count + partition - 1) / partition;
+	fast->plan = fft_plan(size);
+	fast->tap_spectra = malloc(fast->partition_count * size * sizeof(double complex));
+	fast->input_spectra = calloc(fast->partition_count * size, sizeof(double complex));
+	fast->older_sum = calloc(size, sizeof(double complex));
+	fast->work = malloc(size * sizeof(double complex));
+	fast->input = calloc(size, sizeof(double));
+	if (fast->plan == NULL || fast->tap_spectra == NULL || fast->input_spectra == NULL || fast->older_sum == NULL || fast->work == NULL || fast->input == NULL)
+	{
+		fast_convolver_free(fast);
+		return NULL;
+	}
+
+	// Partition p holds taps [p * partition, (p + 1) * partition) followed by zeros.
+	for (int p = 0; p < fast->partition_count; p++)
+	{
+		for (int n = 0; n < size; n++)
+		{
+			int k = p * partition + n;
+			*(fast->work + n) = n < partition && k < tap_count ? *(taps + k) : 0.0;
+		}
+		fft_forward(fast->plan, fast->work, fast->tap_spectra + p * size);
+	}
+
+	return fast;
+}
+
+// Sum of the tap spectra against every input spectrum except the newest.
+static void accumulate_older(struct FastConvolver *fast)
+{
+	int size = 2 * fast->partition;
+
+	memset(fast->older_sum, 0, size * sizeof(double complex));
+	for (int p = 1; p < fast->partition_count; p++)
+	{
+		int slot = (fast->newest - p + fast->partition_count) % fast->partition_count;
+		const double complex *X = fast->input_spectra + slot * size;
+		const double complex *H = fast->tap_spectra + p * size;
+
+		for (int k = 0; k < size; k++)
+		{
+			*(fast->older_sum + k) += fft_cmul(*(X + k), *(H + k));
+		}
+	}
+}
+
+/* Output is available for every input sample, not just completed blocks. A partly filled block is
+ * transformed with zeros in place of samples not yet received, which is exact for a causal filter.
+ * When more input arrives the block is transformed again, only the newest spectrum is recomputed. */
+void fast_convolver_process(struct FastConvolver *fast, const double *input, double *output, long count)
+{
+	int partition = fast->partition;
+	int size = 2 * partition;
+
+	while (count > 0)
+	{
+		int length = count < partition - fast->fill ? count : partition - fast->fill;
+		double complex *newest = fast->input_spectra + fast->newest * size;
+
+		memcpy(fast->input + partition + fast->fill, input, length * sizeof(double));
+		for (int n = 0; n < size; n++)
+		{
+			*(fast->work + n) = *(fast->input + n);
+		}
+		fft_forward(fast->plan, fast->work, newest);
+
+		for (int k = 0; k < size; k++)
+		{
+			*(fast->work + k) = *(fast->older_sum + k) + fft_cmul(*(newest + k), *(fast->tap_spectra + k));
+		}
+		fft_inverse(fast->plan, fast->work, fast->work);
+
+		// The first half of the circular result is aliased, the second half is the linear output.
+		for (int n = 0; n < length; n++)
+		{
+			*(output + n) = creal(*(fast->work + partition + fast->fill + n));
+		}
+
+		fast->fill += length;
+		input += length;
+		output += length;
+		count -= length;
+
+		if (fast->fill == partition)
+		{
+			memcpy(fast->input, fast->input + partition, partition * sizeof(double));
+			memset(fast->input + partition, 0, partition * sizeof(double));
+			fast->newest = (fast->newest + 1) % fast->partition_count;
+			fast->fill = 0;
+			accumulate_older(fast);
+		}
+	}
+}
+
+void fast_convolver_free(struct FastConvolver *fast)
+{
+	if (fast != NULL)
+	{
+		fft_free(fast->plan);
+		free(fast->tap_spectra);
+		free(fast->input_spectra);
+		free(fast->older_sum);
+		free(fast->work);
+		free(fast->input);
+		free(fast);
+	}
+}
+
+/* Direct form below crossover taps, partitioned above. A crossover of 0 or less uses
+ * CONVOLUTION_CROSSOVER, so the engine, and with it the exact output, depends only on the taps. */
+struct Convolver *convolver_create(const double *taps, int tap_count, int crossover)
+{
+	struct Convolver *convolver = calloc(1, sizeof(struct Convolver));
+	if (convolver == NULL)
+	{
+		return NULL;
+	}
+
+	if (tap_count < (crossover > 0 ? crossover : CONVOLUTION_CROSSOVER))
+	{
+		convolver->direct = fir_create(taps, tap_count);
+	}
+	else
+	{
+		convolver->fast = fast_convolver_create(taps, tap_count, 0);
+	}
+
+	if (convolver->direct == NULL && convolver->fast == NULL)
+	{
+		free(convolver);
+		return NULL;
+	}
+	return convolver;
+}
+
+void convolver_process(struct Convolver *convolver, const double *input, double *output, long count)
+{
+	if (convolver->direct != NULL)
+	{
+		fir_process(convolver->direct, input, output, count);
+	}
+	else
+	{
+		fast_convolver_process(convolver->fast, input, output, count);
+	}
+}
+
+void convolver_free(struct Convolver *convolver)
+{
+	if (convolver != NULL)
+	{
+		fir_free(convolver->direct);
+		fast_convolver_free(convolver->fast);
+		free(convolver);
+	}
+}
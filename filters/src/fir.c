@@ -0,0 +1,118 @@
+/************************************************************************************************
+ * FilterTools/fir.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Direct form FIR filtering of long sample streams in blocks.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "fir.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Array of count doubles on a FIR_ALIGNMENT boundary, released with free().
+void *fir_aligned_alloc(long count)
+{
+	size_t size = count * sizeof(double);
+	size = (size + FIR_ALIGNMENT - 1) / FIR_ALIGNMENT * FIR_ALIGNMENT;
+
+	return aligned_alloc(FIR_ALIGNMENT, size > 0 ? size : FIR_ALIGNMENT);
+}
+
+struct FirFilter *fir_create(const double *taps, int tap_count)
+{
+	if (tap_count < 1)
+	{
+		return NULL;
+	}
+
+	struct FirFilter *fir = calloc(1, sizeof(struct FirFilter));
+	if (fir == NULL)
+	{
+		return NULL;
+	}
+
+	fir->tap_count = tap_count;
+	fir->padded_count = (tap_count + FIR_LANES - 1) / FIR_LANES * FIR_LANES;
+	fir->taps = fir_aligned_alloc(fir->padded_count);
+	fir->delay = fir_aligned_alloc(fir->padded_count + FIR_BLOCK_SIZE);
+	if (fir->taps == NULL || fir->delay == NULL)
+	{
+		fir_free(fir);
+		return NULL;
+	}
+
+	// Padding zeros lead the reversed taps so they multiply the oldest, unused history.
+	int padding = fir->padded_count - tap_count;
+	for (int j = 0; j < fir->padded_count; j++)
+	{
+		*(fir->taps + j) = j < padding ? 0.0 : *(taps + fir->padded_count - 1 - j);
+	}
+	fir_reset(fir);
+
+	return fir;
+}
+
+// Clears the delay line, the next sample is filtered as if preceded by silence.
+void fir_reset(struct FirFilter *fir)
+{
+	memset(fir->delay, 0, (fir->padded_count + FIR_BLOCK_SIZE) * sizeof(double));
+}
+
+/* Output n of a block is the dot product of the reversed taps with the delay line starting at
+ * n + 1. The sum is accumulated one tap at a time across the whole block, so the inner loop is a
+ * contiguous multiply-add over outputs that vectorises without reordering any sums. */
+static void fir_block(const struct FirFilter *fir, double *restrict output, int count)
+{
+	const double *restrict delay = fir->delay + 1;
+
+	for (int n = 0; n < count; n++)
+	{
+		*(output + n) = 0.0;
+	}
+	for (int j = 0; j < fir->padded_count; j++)
+	{
+		double tap = *(fir->taps + j);
+		if (tap == 0.0)
+		{
+			continue;
+		}
+		for (int n = 0; n < count; n++)
+		{
+			*(output + n) += tap * *(delay + j + n);
+		}
+	}
+}
+
+/* Filters count samples, continuing from the previous call. The delay line is kept linear and
+ * shifted once per block, so the history stays contiguous with each new block of input. */
+void fir_process(struct FirFilter *fir, const double *input, double *output, long count)
+{
+	double *block = fir->delay + fir->padded_count;
+
+	for (long start = 0; start < count; start += FIR_BLOCK_SIZE)
+	{
+		int length = count - start < FIR_BLOCK_SIZE ? count - start : FIR_BLOCK_SIZE;
+
+		memcpy(block, input + start, length * sizeof(double));
+		fir_block(fir, output + start, length);
+		memmove(fir->delay, fir->delay + length, fir->padded_count * sizeof(double));
+	}
+}
+
+void fir_free(struct FirFilter *fir)
+{
+	if (fir != NULL)
+	{
+		free(fir->taps);
+		free(fir->delay);
+		free(fir);
+	}
+}
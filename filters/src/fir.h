@@ -0,0 +1,35 @@
+#ifndef FIR
+#define FIR
+
+/************************************************************************************************
+ * FilterTools/fir.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Direct form FIR filtering of long sample streams in blocks.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#define FIR_BLOCK_SIZE 1024	// Outputs per block
+#define FIR_LANES 8		// Tap and delay line padding, a multiple of the widest vector in doubles
+#define FIR_ALIGNMENT 64	// Bytes
+
+struct FirFilter {
+	double *taps;		// Time reversed and zero padded to padded_count
+	int tap_count;
+	int padded_count;
+	double *delay;		// padded_count history samples followed by one block of input
+};
+
+struct FirFilter *fir_create(const double *taps, int tap_count);
+void fir_reset(struct FirFilter *fir);
+void fir_process(struct FirFilter *fir, const double *input, double *output, long count);
+void fir_free(struct FirFilter *fir);
+void *fir_aligned_alloc(long count);
+
+#endif
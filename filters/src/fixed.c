@@ -0,0 +1,431 @@
+/************************************************************************************************
+ * FilterTools/fixed.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Q15 and Q31 fixed point FIR, biquad and FFT kernels with saturating
+ * 		  arithmetic, matching the integer pipelines of the embedded targets.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "fixed.h"
+#include "fir.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+// Array of count elements of size bytes on a FIR_ALIGNMENT boundary, released with free().
+static void *aligned_codes(long count, size_t size)
+{
+	size_t bytes = count * size;
+	bytes = (bytes + FIR_ALIGNMENT - 1) / FIR_ALIGNMENT * FIR_ALIGNMENT;
+
+	return aligned_alloc(FIR_ALIGNMENT, bytes > 0 ? bytes : FIR_ALIGNMENT);
+}
+
+int fixed_fraction_bits(enum FixedFormat format)
+{
+	return format == Q15 ? 15 : 31;
+}
+
+// Clips to the format's range, -1 to one step short of +1.
+int32_t fixed_saturate(int64_t value, int fraction_bits)
+{
+	int64_t limit = (int64_t) 1 << fraction_bits;
+
+	if (value > limit - 1)
+	{
+		return (int32_t) (limit - 1);
+	}
+	if (value < -limit)
+	{
+		return (int32_t) -limit;
+	}
+	return (int32_t) value;
+}
+
+// Arithmetic shift right rounding to nearest, ties towards +infinity as the targets' rounding shifts.
+static inline int64_t round_shift(int64_t value, int shift)
+{
+	return shift > 0 ? (value + ((int64_t) 1 << (shift - 1))) >> shift : value;
+}
+
+int32_t fixed_from_double(double value, int fraction_bits)
+{
+	double level = ldexp(value, fraction_bits);
+	double limit = ldexp(1.0, fraction_bits);
+
+	level = level > limit ? limit : level < -limit ? -limit : level;
+	return fixed_saturate(llrint(level), fraction_bits);
+}
+
+double fixed_to_double(int32_t code, int fraction_bits)
+{
+	return ldexp((double) code, -fraction_bits);
+}
+
+q15_t q15_from_double(double value)
+{
+	return (q15_t) fixed_from_double(value, 15);
+}
+
+q31_t q31_from_double(double value)
+{
+	return (q31_t) fixed_from_double(value, 31);
+}
+
+// Smallest power of two that brings every value inside the format, or FIXED_GUARD_BITS + 1 if none will.
+static int fit_shift(const double *values, int count, int fraction_bits)
+{
+	double largest_code = 1.0 - ldexp(1.0, -fraction_bits);
+	double largest = 0.0;
+	int shift = 0;
+
+	for (int k = 0; k < count; k++)
+	{
+		if (!isfinite(*(values + k)))
+		{
+			return FIXED_GUARD_BITS + 1;
+		}
+		largest = fabs(*(values + k)) > largest ? fabs(*(values + k)) : largest;
+	}
+	while (shift <= FIXED_GUARD_BITS && ldexp(largest, -shift) > largest_code)
+	{
+		shift++;
+	}
+	return shift;
+}
+
+/* Taps of magnitude 1 or more are scaled down by a power of two like biquad coefficients, and the
+ * output scaled back up after accumulation. Returns NULL if that needs more than FIXED_GUARD_BITS
+ * of scaling. */
+struct FixedFir *fixed_fir_create(const double *taps, int tap_count, int fraction_bits)
+{
+	int shift = tap_count > 0 ? fit_shift(taps, tap_count, fraction_bits) : 0;
+	if (tap_count < 1 || shift > FIXED_GUARD_BITS)
+	{
+		return NULL;
+	}
+
+	struct FixedFir *fir = calloc(1, sizeof(struct FixedFir));
+	if (fir == NULL)
+	{
+		return NULL;
+	}
+
+	fir->fraction_bits = fraction_bits;
+	fir->tap_count = tap_count;
+	fir->padded_count = (tap_count + FIR_LANES - 1) / FIR_LANES * FIR_LANES;
+	fir->shift = shift;
+	fir->taps = aligned_codes(fir->padded_count, sizeof(int32_t));
+	fir->delay = aligned_codes(fir->padded_count + FIXED_BLOCK_SIZE, sizeof(int32_t));
+	fir->sums = aligned_codes(FIXED_BLOCK_SIZE, sizeof(int64_t));
+	if (fir->taps == NULL || fir->delay == NULL || fir->sums == NULL)
+	{
+		fixed_fir_free(fir);
+		return NULL;
+	}
+
+	int padding = fir->padded_count - tap_count;
+	for (int j = 0; j < fir->padded_count; j++)
+	{
+		*(fir->taps + j) = j < padding ? 0 : fixed_from_double(ldexp(*(taps + fir->padded_count - 1 - j), -shift), fraction_bits);
+	}
+	fixed_fir_reset(fir);
+
+	return fir;
+}
+
+void fixed_fir_reset(struct FixedFir *fir)
+{
+	memset(fir->delay, 0, (fir->padded_count + FIXED_BLOCK_SIZE) * sizeof(int32_t));
+}
+
+/* As fir_block, one tap at a time across the block. The widening multiply, shift and add over
+ * contiguous outputs is what the compiler turns into integer vector instructions. */
+static void fixed_fir_block(const struct FixedFir *fir, int32_t *output, int count)
+{
+	const int32_t *restrict delay = fir->delay + 1;
+	int64_t *restrict sums = fir->sums;
+	int drop = fir->fraction_bits - FIXED_GUARD_BITS;
+
+	for (int n = 0; n < count; n++)
+	{
+		*(sums + n) = 0;
+	}
+	for (int j = 0; j < fir->padded_count; j++)
+	{
+		int64_t tap = *(fir->taps + j);
+		if (tap == 0)
+		{
+			continue;
+		}
+		for (int n = 0; n < count; n++)
+		{
+			*(sums + n) += (tap * *(delay + j + n)) >> drop;
+		}
+	}
+	for (int n = 0; n < count; n++)
+	{
+		*(output + n) = fixed_saturate(round_shift(*(sums + n), FIXED_GUARD_BITS - fir->shift), fir->fraction_bits);
+	}
+}
+
+// Filters count codes, continuing from the previous call.
+void fixed_fir_process(struct FixedFir *fir, const int32_t *input, int32_t *output, long count)
+{
+	int32_t *block = fir->delay + fir->padded_count;
+
+	for (long start = 0; start < count; start += FIXED_BLOCK_SIZE)
+	{
+		int length = count - start < FIXED_BLOCK_SIZE ? count - start : FIXED_BLOCK_SIZE;
+
+		memcpy(block, input + start, length * sizeof(int32_t));
+		fixed_fir_block(fir, output + start, length);
+		memmove(fir->delay, fir->delay + length, fir->padded_count * sizeof(int32_t));
+	}
+}
+
+void fixed_fir_free(struct FixedFir *fir)
+{
+	if (fir != NULL)
+	{
+		free(fir->taps);
+		free(fir->delay);
+		free(fir->sums);
+		free(fir);
+	}
+}
+
+/* Largest difference between the responses of a section's exact coefficients, b0 b1 b2 a1 a2 with
+ * a0 = 1, and its quantised ones over FIXED_RESPONSE_POINTS frequencies from DC to Nyquist,
+ * relative to the exact response's peak. */
+static double section_error(const double *exact, const struct FixedSection *section, int fraction_bits)
+{
+	int scale = section->shift - fraction_bits;
+	double quantised[5] = { ldexp(section->b0, scale), ldexp(section->b1, scale), ldexp(section->b2, scale), ldexp(section->a1, scale), ldexp(section->a2, scale) };
+	double peak = 0.0;
+	double error = 0.0;
+
+	for (int k = 0; k < FIXED_RESPONSE_POINTS; k++)
+	{
+		double complex z1 = cexp(-I * M_PI * k / (FIXED_RESPONSE_POINTS - 1));
+		double complex z2 = z1 * z1;
+		double complex response = (exact[0] + exact[1] * z1 + exact[2] * z2) / (1.0 + exact[3] * z1 + exact[4] * z2);
+		double complex actual = (quantised[0] + quantised[1] * z1 + quantised[2] * z2) / (1.0 + quantised[3] * z1 + quantised[4] * z2);
+
+		peak = cabs(response) > peak ? cabs(response) : peak;
+		error = cabs(actual - response) > error ? cabs(actual - response) : error;
+	}
+	return peak > 0.0 ? error / peak : 0.0;
+}
+
+/* Coefficients are six per section, b0 b1 b2 a0 a1 a2. Each section is normalised to a0 = 1 and
+ * scaled down by the smallest power of two that brings every coefficient inside the format, the
+ * output being scaled back up after accumulation. Returns NULL if a section needs more than
+ * FIXED_GUARD_BITS of scaling, or if its quantised response strays from the exact one by more
+ * than FIXED_SECTION_TOLERANCE, as a section with coefficients of only a few codes does. */
+struct FixedBiquad *fixed_biquad_create(const double *coefficients, int section_count, int channels, int fraction_bits)
+{
+	if (section_count < 1 || channels < 1)
+	{
+		return NULL;
+	}
+
+	struct FixedBiquad *cascade = calloc(1, sizeof(struct FixedBiquad));
+	if (cascade == NULL)
+	{
+		return NULL;
+	}
+
+	cascade->fraction_bits = fraction_bits;
+	cascade->section_count = section_count;
+	cascade->channels = channels;
+	cascade->sections = malloc(section_count * sizeof(struct FixedSection));
+	cascade->state = malloc((size_t) 4 * section_count * channels * sizeof(int32_t));
+	if (cascade->sections == NULL || cascade->state == NULL)
+	{
+		fixed_biquad_free(cascade);
+		return NULL;
+	}
+
+	for (int s = 0; s < section_count; s++)
+	{
+		const double *c = coefficients + 6 * s;
+		double normalised[5] = { *c / *(c + 3), *(c + 1) / *(c + 3), *(c + 2) / *(c + 3), *(c + 4) / *(c + 3), *(c + 5) / *(c + 3) };
+		int shift = fit_shift(normalised, 5, fraction_bits);
+		if (shift > FIXED_GUARD_BITS)
+		{
+			fixed_biquad_free(cascade);
+			return NULL;
+		}
+
+		struct FixedSection *section = cascade->sections + s;
+		section->b0 = fixed_from_double(ldexp(normalised[0], -shift), fraction_bits);
+		section->b1 = fixed_from_double(ldexp(normalised[1], -shift), fraction_bits);
+		section->b2 = fixed_from_double(ldexp(normalised[2], -shift), fraction_bits);
+		section->a1 = fixed_from_double(ldexp(normalised[3], -shift), fraction_bits);
+		section->a2 = fixed_from_double(ldexp(normalised[4], -shift), fraction_bits);
+		section->shift = shift;
+		if (section_error(normalised, section, fraction_bits) > FIXED_SECTION_TOLERANCE)
+		{
+			fixed_biquad_free(cascade);
+			return NULL;
+		}
+	}
+	fixed_biquad_reset(cascade);
+
+	return cascade;
+}
+
+void fixed_biquad_reset(struct FixedBiquad *cascade)
+{
+	memset(cascade->state, 0, (size_t) 4 * cascade->section_count * cascade->channels * sizeof(int32_t));
+}
+
+/* Filters count codes of one channel in place, continuing from that channel's previous call.
+ * Outputs are saturated before they are fed back, as on the targets, so an overload clips
+ * instead of wrapping into a limit cycle. */
+void fixed_biquad_process(struct FixedBiquad *cascade, int channel, int32_t *samples, long count)
+{
+	int drop = cascade->fraction_bits - FIXED_GUARD_BITS;
+
+	for (int s = 0; s < cascade->section_count; s++)
+	{
+		const struct FixedSection *section = cascade->sections + s;
+		int32_t *state = cascade->state + 4 * ((size_t) channel * cascade->section_count + s);
+		int64_t x1 = *state, x2 = *(state + 1), y1 = *(state + 2), y2 = *(state + 3);
+
+		for (long n = 0; n < count; n++)
+		{
+			int64_t x0 = *(samples + n);
+			int64_t sum = ((section->b0 * x0) >> drop) + ((section->b1 * x1) >> drop) + ((section->b2 * x2) >> drop)
+				- ((section->a1 * y1) >> drop) - ((section->a2 * y2) >> drop);
+			int64_t y0 = fixed_saturate(round_shift(sum, FIXED_GUARD_BITS - section->shift), cascade->fraction_bits);
+
+			x2 = x1;
+			x1 = x0;
+			y2 = y1;
+			y1 = y0;
+			*(samples + n) = (int32_t) y0;
+		}
+
+		*state = (int32_t) x1;
+		*(state + 1) = (int32_t) x2;
+		*(state + 2) = (int32_t) y1;
+		*(state + 3) = (int32_t) y2;
+	}
+}
+
+void fixed_biquad_free(struct FixedBiquad *cascade)
+{
+	if (cascade != NULL)
+	{
+		free(cascade->sections);
+		free(cascade->state);
+		free(cascade);
+	}
+}
+
+// Twiddles are quantised once, so cos(0) saturates to the largest code exactly as on the targets.
+struct FixedFft *fixed_fft_create(int size, int fraction_bits)
+{
+	if (size < 2 || (size & (size - 1)) != 0)
+	{
+		return NULL;
+	}
+
+	struct FixedFft *fft = calloc(1, sizeof(struct FixedFft));
+	if (fft == NULL)
+	{
+		return NULL;
+	}
+
+	fft->fraction_bits = fraction_bits;
+	fft->size = size;
+	fft->twiddles = aligned_codes(size, sizeof(int32_t));
+	if (fft->twiddles == NULL)
+	{
+		fixed_fft_free(fft);
+		return NULL;
+	}
+
+	for (int k = 0; k < size / 2; k++)
+	{
+		double angle = 2.0 * M_PI * k / size;
+		*(fft->twiddles + 2 * k) = fixed_from_double(cos(angle), fraction_bits);
+		*(fft->twiddles + 2 * k + 1) = fixed_from_double(-sin(angle), fraction_bits);
+	}
+
+	return fft;
+}
+
+/* In place radix-2 decimation in time transform of size interleaved real and imaginary codes.
+ * Every stage halves its outputs, so nothing can overflow and the result is the DFT divided by
+ * size, the same block scaling the targets' fixed point transforms apply. */
+void fixed_fft_forward(const struct FixedFft *fft, int32_t *data)
+{
+	int size = fft->size;
+	int drop = fft->fraction_bits - FIXED_GUARD_BITS;
+
+	for (int i = 1, j = 0; i < size; i++)
+	{
+		int bit = size >> 1;
+		for (; j & bit; bit >>= 1)
+		{
+			j ^= bit;
+		}
+		j ^= bit;
+		if (i < j)
+		{
+			int32_t re = *(data + 2 * i), im = *(data + 2 * i + 1);
+			*(data + 2 * i) = *(data + 2 * j);
+			*(data + 2 * i + 1) = *(data + 2 * j + 1);
+			*(data + 2 * j) = re;
+			*(data + 2 * j + 1) = im;
+		}
+	}
+
+	for (int half = 1; half < size; half *= 2)
+	{
+		int stride = size / (2 * half);
+
+		for (int start = 0; start < size; start += 2 * half)
+		{
+			int32_t *restrict a = data + 2 * start;
+			int32_t *restrict b = a + 2 * half;
+
+			for (int k = 0; k < half; k++)
+			{
+				int64_t wr = *(fft->twiddles + 2 * k * stride);
+				int64_t wi = *(fft->twiddles + 2 * k * stride + 1);
+				int64_t br = *(b + 2 * k), bi = *(b + 2 * k + 1);
+				int64_t tr = ((wr * br) >> drop) - ((wi * bi) >> drop);
+				int64_t ti = ((wr * bi) >> drop) + ((wi * br) >> drop);
+				int64_t ar = (int64_t) *(a + 2 * k) * ((int64_t) 1 << FIXED_GUARD_BITS);
+				int64_t ai = (int64_t) *(a + 2 * k + 1) * ((int64_t) 1 << FIXED_GUARD_BITS);
+
+				*(a + 2 * k) = fixed_saturate(round_shift(ar + tr, FIXED_GUARD_BITS + 1), fft->fraction_bits);
+				*(a + 2 * k + 1) = fixed_saturate(round_shift(ai + ti, FIXED_GUARD_BITS + 1), fft->fraction_bits);
+				*(b + 2 * k) = fixed_saturate(round_shift(ar - tr, FIXED_GUARD_BITS + 1), fft->fraction_bits);
+				*(b + 2 * k + 1) = fixed_saturate(round_shift(ai - ti, FIXED_GUARD_BITS + 1), fft->fraction_bits);
+			}
+		}
+	}
+}
+
+void fixed_fft_free(struct FixedFft *fft)
+{
+	if (fft != NULL)
+	{
+		free(fft->twiddles);
+		free(fft);
+	}
+}
@@ -0,0 +1,90 @@
+#ifndef FIXED
+#define FIXED
+
+/************************************************************************************************
+ * FilterTools/fixed.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Q15 and Q31 fixed point FIR, biquad and FFT kernels with saturating
+ * 		  arithmetic, matching the integer pipelines of the embedded targets.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <stdint.h>
+
+#define FIXED_FORMAT_NAMES { "q15", "q31" }
+#define FIXED_BLOCK_SIZE 1024	// Outputs per block
+#define FIXED_GUARD_BITS 15	// Products are kept to fraction bits + FIXED_GUARD_BITS
+#define FIXED_RESPONSE_POINTS 256	// Frequencies a quantised biquad section is checked at
+#define FIXED_SECTION_TOLERANCE 1e-2	// Largest response error of a quantised section, relative to its peak
+
+enum FixedFormat { Q15, Q31 };
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+/* Every kernel holds codes in 32 bit containers whatever the format, so Q15 and Q31 share one
+ * implementation. Products accumulate in 64 bits with FIXED_GUARD_BITS below the output's least
+ * significant bit, which is exact for Q15 and leaves 17 bits of headroom for Q31. */
+struct FixedFir {
+	int fraction_bits;	// 15 or 31
+	int tap_count;
+	int padded_count;
+	int shift;		// Taps scaled down by 2^shift to fit the format
+	int32_t *taps;		// Time reversed and zero padded to padded_count
+	int32_t *delay;		// padded_count history samples followed by one block of input
+	int64_t *sums;		// One block of accumulators
+};
+
+// Direct form I, coefficients scaled down by 2^shift to fit the format and a0 = 1.
+struct FixedSection {
+	int32_t b0;
+	int32_t b1;
+	int32_t b2;
+	int32_t a1;
+	int32_t a2;
+	int shift;
+};
+
+struct FixedBiquad {
+	int fraction_bits;
+	int section_count;
+	int channels;
+	struct FixedSection *sections;	// Shared by all channels
+	int32_t *state;			// x1, x2, y1, y2 per section per channel
+};
+
+struct FixedFft {
+	int fraction_bits;
+	int size;		// Power of two
+	int32_t *twiddles;	// size / 2 interleaved cos and -sin
+};
+
+int fixed_fraction_bits(enum FixedFormat format);
+int32_t fixed_saturate(int64_t value, int fraction_bits);
+int32_t fixed_from_double(double value, int fraction_bits);
+double fixed_to_double(int32_t code, int fraction_bits);
+q15_t q15_from_double(double value);
+q31_t q31_from_double(double value);
+
+struct FixedFir *fixed_fir_create(const double *taps, int tap_count, int fraction_bits);
+void fixed_fir_reset(struct FixedFir *fir);
+void fixed_fir_process(struct FixedFir *fir, const int32_t *input, int32_t *output, long count);
+void fixed_fir_free(struct FixedFir *fir);
+
+struct FixedBiquad *fixed_biquad_create(const double *coefficients, int section_count, int channels, int fraction_bits);
+void fixed_biquad_reset(struct FixedBiquad *cascade);
+void fixed_biquad_process(struct FixedBiquad *cascade, int channel, int32_t *samples, long count);
+void fixed_biquad_free(struct FixedBiquad *cascade);
+
+struct FixedFft *fixed_fft_create(int size, int fraction_bits);
+void fixed_fft_forward(const struct FixedFft *fft, int32_t *data);
+void fixed_fft_free(struct FixedFft *fft);
+
+#endif
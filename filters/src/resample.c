@@ -0,0 +1,366 @@
+/************************************************************************************************
+ * FilterTools/resample.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Polyphase rational resampling and a planner splitting large rate changes into
+ * 		  cheaper interpolation and decimation stages.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "resample.h"
+#include "fir.h"
+#include "design.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define RESAMPLE_MAX_FACTORISATIONS 256
+
+static int gcd(int a, int b)
+{
+	while (b != 0)
+	{
+		int t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+/* The prototype lowpass runs at up times the input rate. It is split into up phases, phase p
+ * holding taps p, p + up, p + 2 up and so on, so each output only touches the taps that meet a
+ * real input sample. Taps are scaled by up to make up for the zeros interpolation inserts. */
+struct Resampler *resampler_create(int up, int down, const double *taps, int tap_count)
+{
+	if (up < 1 || down < 1 || tap_count < 1)
+	{
+		return NULL;
+	}
+
+	struct Resampler *resampler = calloc(1, sizeof(struct Resampler));
+	if (resampler == NULL)
+	{
+		return NULL;
+	}
+
+	int divisor = gcd(up, down);
+	resampler->up = up / divisor;
+	resampler->down = down / divisor;
+	resampler->taps_per_phase = (tap_count + resampler->up - 1) / resampler->up;
+	resampler->taps_per_phase = (resampler->taps_per_phase + FIR_LANES - 1) / FIR_LANES * FIR_LANES;
+
+	int length = resampler->taps_per_phase;
+	resampler->phases = fir_aligned_alloc((long) resampler->up * length);
+	resampler->work = fir_aligned_alloc(length - 1 + RESAMPLE_BLOCK_SIZE);
+	if (resampler->phases == NULL || resampler->work == NULL)
+	{
+		resampler_free(resampler);
+		return NULL;
+	}
+
+	for (int p = 0; p < resampler->up; p++)
+	{
+		for (int q = 0; q < length; q++)
+		{
+			long k = p + (long) (length - 1 - q) * resampler->up;
+			*(resampler->phases + (long) p * length + q) = k < tap_count ? resampler->up * *(taps + k) : 0.0;
+		}
+	}
+	memset(resampler->work, 0, (length - 1 + RESAMPLE_BLOCK_SIZE) * sizeof(double));
+
+	return resampler;
+}
+
+// Number of outputs the next count inputs will produce.
+long resampler_output_limit(const struct Resampler *resampler, long count)
+{
+	long span = count * resampler->up - resampler->position;
+	return span > 0 ? (span + resampler->down - 1) / resampler->down : 0;
+}
+
+// Partial sums across FIR_LANES accumulators keep the dot product vectorisable without reordering.
+static double phase_dot(const double *restrict taps, const double *restrict x, int length)
+{
+	double sum[FIR_LANES] = { 0.0 };
+
+	for (int q = 0; q < length; q += FIR_LANES)
+	{
+		for (int l = 0; l < FIR_LANES; l++)
+		{
+			sum[l] += *(taps + q + l) * *(x + q + l);
+		}
+	}
+
+	double total = 0.0;
+	for (int l = 0; l < FIR_LANES; l++)
+	{
+		total += sum[l];
+	}
+	return total;
+}
+
+/* Resamples count inputs, continuing from the previous call, into output which must hold
+ * resampler_output_limit() samples. Returns the number of outputs written. */
+long resampler_process(struct Resampler *resampler, const double *input, long count, double *output)
+{
+	int length = resampler->taps_per_phase;
+	long produced = 0;
+
+	for (long start = 0; start < count; start += RESAMPLE_BLOCK_SIZE)
+	{
+		long block = count - start < RESAMPLE_BLOCK_SIZE ? count - start : RESAMPLE_BLOCK_SIZE;
+		long span = block * resampler->up;
+
+		memcpy(resampler->work + length - 1, input + start, block * sizeof(double));
+		while (resampler->position < span)
+		{
+			long i = resampler->position / resampler->up;
+			long p = resampler->position % resampler->up;
+
+			*(output + produced++) = phase_dot(resampler->phases + p * length, resampler->work + i, length);
+			resampler->position += resampler->down;
+		}
+		resampler->position -= span;
+		memmove(resampler->work, resampler->work + block, (length - 1) * sizeof(double));
+	}
+
+	return produced;
+}
+
+void resampler_free(struct Resampler *resampler)
+{
+	if (resampler != NULL)
+	{
+		free(resampler->phases);
+		free(resampler->work);
+		free(resampler);
+	}
+}
+
+/* Every ordered way of writing n as a product of at most RESAMPLE_MAX_FACTORS factors, each at
+ * least 2. A factorisation is terminated by 0 when shorter than the maximum. */
+static int factorise(int n, int *current, int depth, int (*list)[RESAMPLE_MAX_FACTORS], int count)
+{
+	if (n == 1 || depth == RESAMPLE_MAX_FACTORS)
+	{
+		if (n == 1 && count < RESAMPLE_MAX_FACTORISATIONS)
+		{
+			for (int i = 0; i < RESAMPLE_MAX_FACTORS; i++)
+			{
+				list[count][i] = i < depth ? *(current + i) : 0;
+			}
+			count++;
+		}
+		return count;
+	}
+
+	for (int factor = 2; factor <= n; factor++)
+	{
+		if (n % factor == 0)
+		{
+			*(current + depth) = factor;
+			count = factorise(n / factor, current, depth + 1, list, count);
+		}
+	}
+	return count;
+}
+
+/* Fills in taps and cutoff for each stage and returns the multiply-adds per final output, or a
+ * negative value if a stage cannot keep the final band free of images and aliases. Rates are
+ * relative to the input rate. Each stage must keep images and aliases out of the final band
+ * [0, stop], so its own stopband starts at stop below the lower of its input and output rates. */
+static double plan_cost(struct ResamplePlan *plan, double final_rate)
+{
+	double stop = (final_rate < 1.0 ? final_rate : 1.0) / 2.0;
+	double pass = RESAMPLE_PASSBAND * stop;
+	double rate = 1.0;
+	double cost = 0.0;
+
+	plan->delay = 0.0;
+
+	for (int s = 0; s < plan->stage_count; s++)
+	{
+		struct ResampleStage *stage = &plan->stages[s];
+		double upsampled = rate * stage->up;
+		double output_rate = upsampled / stage->down;
+		double stage_stop = (rate < output_rate ? rate : output_rate) - stop;
+		double transition = stage_stop - pass;
+
+		if (transition <= 0.0)
+		{
+			return -1.0;
+		}
+		stage->taps = (int) ceil(RESAMPLE_WINDOW_WIDTH * upsampled / transition);
+		stage->taps += stage->taps % 2 == 0;
+		stage->cutoff = (pass + stage_stop) / 2.0 / upsampled;
+		cost += (double) stage->taps / stage->up * output_rate / final_rate;
+		plan->delay += (stage->taps - 1) / 2.0 / upsampled * final_rate;
+		rate = output_rate;
+	}
+	return cost;
+}
+
+/* Chooses stages for a rate change of up / down with the fewest multiply-adds per output sample.
+ * Candidates are every factorisation of up as interpolation stages followed by every
+ * factorisation of down as decimation stages, with or without the middle pair merged into one
+ * rational stage. Returns 0 if no plan was possible. */
+int resample_plan(int up, int down, struct ResamplePlan *plan)
+{
+	if (up < 1 || down < 1)
+	{
+		return 0;
+	}
+
+	int divisor = gcd(up, down);
+	up /= divisor;
+	down /= divisor;
+
+	// Nothing to filter, the chain copies its input.
+	if (up == 1 && down == 1)
+	{
+		*plan = (struct ResamplePlan) { 0 };
+		return 1;
+	}
+
+	static int up_factors[RESAMPLE_MAX_FACTORISATIONS][RESAMPLE_MAX_FACTORS];
+	static int down_factors[RESAMPLE_MAX_FACTORISATIONS][RESAMPLE_MAX_FACTORS];
+	int current[RESAMPLE_MAX_FACTORS];
+	int up_count = factorise(up, current, 0, up_factors, 0);
+	int down_count = factorise(down, current, 0, down_factors, 0);
+	double final_rate = (double) up / down;
+
+	plan->stage_count = 0;
+	plan->macs_per_output = -1.0;
+	for (int u = 0; u < up_count; u++)
+	{
+		for (int d = 0; d < down_count; d++)
+		{
+			for (int merge = 0; merge < 2; merge++)
+			{
+				struct ResamplePlan candidate = { 0 };
+
+				for (int i = 0; i < RESAMPLE_MAX_FACTORS && up_factors[u][i] != 0; i++)
+				{
+					candidate.stages[candidate.stage_count++] = (struct ResampleStage) { up_factors[u][i], 1, 0, 0.0 };
+				}
+				int first_down = 0;
+				if (merge && candidate.stage_count > 0 && down_factors[d][0] != 0)
+				{
+					candidate.stages[candidate.stage_count - 1].down = down_factors[d][0];
+					first_down = 1;
+				}
+				else if (merge)
+				{
+					continue;
+				}
+				for (int i = first_down; i < RESAMPLE_MAX_FACTORS && down_factors[d][i] != 0; i++)
+				{
+					candidate.stages[candidate.stage_count++] = (struct ResampleStage) { 1, down_factors[d][i], 0, 0.0 };
+				}
+
+				candidate.macs_per_output = plan_cost(&candidate, final_rate);
+				if (candidate.macs_per_output >= 0.0 && (plan->macs_per_output < 0.0 || candidate.macs_per_output < plan->macs_per_output))
+				{
+					*plan = candidate;
+				}
+			}
+		}
+	}
+
+	return plan->macs_per_output >= 0.0;
+}
+
+// Stage prototypes come from the design cache, so chains for several channels share each design.
+struct ResampleChain *resample_chain_create(const struct ResamplePlan *plan)
+{
+	struct ResampleChain *chain = calloc(1, sizeof(struct ResampleChain));
+	if (chain == NULL)
+	{
+		return NULL;
+	}
+
+	chain->stage_count = plan->stage_count;
+	for (int s = 0; s < plan->stage_count; s++)
+	{
+		const struct ResampleStage *stage = &plan->stages[s];
+		struct FilterSpec spec = { WINDOWED_SINC, LOWPASS, stage->taps, 1.0, { stage->cutoff, 0.0 }, 0.0, 0.0, 0.0 };
+		const struct FilterDesign *design = filter_design(&spec);
+
+		chain->stages[s] = design != NULL ? resampler_create(stage->up, stage->down, design->coefficients, design->count) : NULL;
+		if (chain->stages[s] == NULL)
+		{
+			resample_chain_free(chain);
+			return NULL;
+		}
+	}
+
+	return chain;
+}
+
+long resample_chain_output_limit(const struct ResampleChain *chain, long count)
+{
+	for (int s = 0; s < chain->stage_count; s++)
+	{
+		count = resampler_output_limit(chain->stages[s], count);
+	}
+	return count;
+}
+
+// Runs count inputs through every stage. Intermediate rates alternate between two buffers.
+long resample_chain_process(struct ResampleChain *chain, const double *input, long count, double *output)
+{
+	if (chain->stage_count == 0)
+	{
+		memmove(output, input, count * sizeof(double));
+		return count;
+	}
+
+	long needed = count;
+	for (int s = 0; s < chain->stage_count - 1; s++)
+	{
+		needed = resampler_output_limit(chain->stages[s], needed);
+		if (needed > chain->buffer_size)
+		{
+			for (int b = 0; b < 2; b++)
+			{
+				free(chain->buffers[b]);
+				chain->buffers[b] = fir_aligned_alloc(needed);
+			}
+			chain->buffer_size = chain->buffers[0] != NULL && chain->buffers[1] != NULL ? needed : 0;
+			if (chain->buffer_size == 0)
+			{
+				return 0;
+			}
+		}
+	}
+
+	const double *source = input;
+	for (int s = 0; s < chain->stage_count; s++)
+	{
+		double *destination = s == chain->stage_count - 1 ? output : chain->buffers[s % 2];
+		count = resampler_process(chain->stages[s], source, count, destination);
+		source = destination;
+	}
+	return count;
+}
+
+void resample_chain_free(struct ResampleChain *chain)
+{
+	if (chain != NULL)
+	{
+		for (int s = 0; s < chain->stage_count; s++)
+		{
+			resampler_free(chain->stages[s]);
+		}
+		free(chain->buffers[0]);
+		free(chain->buffers[1]);
+		free(chain);
+	}
+}
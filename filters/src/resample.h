@@ -0,0 +1,66 @@
+#ifndef RESAMPLE
+#define RESAMPLE
+
+/************************************************************************************************
+ * FilterTools/resample.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Polyphase rational resampling and a planner splitting large rate changes into
+ * 		  cheaper interpolation and decimation stages.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#define RESAMPLE_BLOCK_SIZE 4096	// Input samples per block
+#define RESAMPLE_MAX_FACTORS 4		// Most stages either rate factor is split into
+#define RESAMPLE_MAX_STAGES (2 * RESAMPLE_MAX_FACTORS)
+#define RESAMPLE_PASSBAND 0.9		// Fraction of the final band kept flat
+#define RESAMPLE_WINDOW_WIDTH 3.3	// Hamming transition width in bins, taps = width / transition
+
+struct Resampler {
+	int up;
+	int down;
+	int taps_per_phase;
+	double *phases;		// up phases of taps_per_phase, each time reversed
+	double *work;		// taps_per_phase - 1 history samples followed by one block
+	long position;		// Upsampled time of the next output, relative to the next input
+};
+
+struct ResampleStage {
+	int up;
+	int down;
+	int taps;
+	double cutoff;		// Prototype cutoff relative to the stage's upsampled rate
+};
+
+struct ResamplePlan {
+	int stage_count;	// 0 for a 1:1 ratio, which is a plain copy
+	struct ResampleStage stages[RESAMPLE_MAX_STAGES];
+	double macs_per_output;
+	double delay;		// Group delay of the linear phase stages, in output samples
+};
+
+struct ResampleChain {
+	int stage_count;
+	struct Resampler *stages[RESAMPLE_MAX_STAGES];
+	double *buffers[2];
+	long buffer_size;
+};
+
+struct Resampler *resampler_create(int up, int down, const double *taps, int tap_count);
+long resampler_output_limit(const struct Resampler *resampler, long count);
+long resampler_process(struct Resampler *resampler, const double *input, long count, double *output);
+void resampler_free(struct Resampler *resampler);
+
+int resample_plan(int up, int down, struct ResamplePlan *plan);
+struct ResampleChain *resample_chain_create(const struct ResamplePlan *plan);
+long resample_chain_output_limit(const struct ResampleChain *chain, long count);
+long resample_chain_process(struct ResampleChain *chain, const double *input, long count, double *output);
+void resample_chain_free(struct ResampleChain *chain);
+
+#endif
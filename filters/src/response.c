@@ -0,0 +1,259 @@
+/************************************************************************************************
+ * FilterTools/response.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Frequency response analysis of FIR taps and biquad cascades. Magnitude, phase
+ * 		  and group delay come from zero padded transforms of the coefficients over the
+ * 		  whole band, or from a chirp-z transform zoomed onto a narrow one.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "response.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define RESPONSE_DELAY_FLOOR 1e-300	// |P|^2 below which a polynomial's delay is taken as 0
+
+/* Bluestein's chirp-z transform, X[k] = sum x[n] A^-n W^nk with A on the unit circle at the first
+ * frequency and W stepping by the grid spacing. Writing nk as (n^2 + k^2 - (k - n)^2) / 2 turns it
+ * into a convolution with the chirp W^(-m^2 / 2), whose transform is computed here once. */
+struct ChirpZ *chirp_z_create(int length, const struct ResponseGrid *grid)
+{
+	if (length < 1 || grid->points < 2 || grid->sample_rate <= 0.0)
+	{
+		return NULL;
+	}
+
+	struct ChirpZ *czt = calloc(1, sizeof(struct ChirpZ));
+	if (czt == NULL)
+	{
+		return NULL;
+	}
+
+	czt->length = length;
+	czt->points = grid->points;
+	czt->size = fft_next_power_of_2(length + grid->points - 1);
+	czt->plan = fft_cached_plan(czt->size);
+	czt->premultiply = malloc(length * sizeof(double complex));
+	czt->postmultiply = malloc(grid->points * sizeof(double complex));
+	czt->kernel = calloc(czt->size, sizeof(double complex));
+	czt->work = malloc(czt->size * sizeof(double complex));
+	if (czt->plan == NULL || czt->premultiply == NULL || czt->postmultiply == NULL || czt->kernel == NULL || czt->work == NULL)
+	{
+		chirp_z_free(czt);
+		return NULL;
+	}
+
+	double start = 2.0 * M_PI * grid->first / grid->sample_rate;
+	double step = 2.0 * M_PI * (grid->last - grid->first) / ((grid->points - 1) * grid->sample_rate);
+	for (int n = 0; n < length; n++)
+	{
+		*(czt->premultiply + n) = cexp(-I * (start * n + step * n * (double) n / 2.0));
+	}
+	for (int k = 0; k < grid->points; k++)
+	{
+		*(czt->postmultiply + k) = cexp(-I * step * k * (double) k / 2.0);
+	}
+	for (int m = 0; m < grid->points; m++)
+	{
+		*(czt->kernel + m) = cexp(I * step * m * (double) m / 2.0);
+	}
+	for (int m = 1; m < length; m++)
+	{
+		*(czt->kernel + czt->size - m) = cexp(I * step * m * (double) m / 2.0);
+	}
+	fft_forward(czt->plan, czt->kernel, czt->kernel);
+
+	return czt;
+}
+
+// Transforms length <= czt->length inputs onto the grid, writing czt->points outputs.
+void chirp_z_transform(struct ChirpZ *czt, const double complex *input, int length, double complex *output)
+{
+	memset(czt->work, 0, czt->size * sizeof(double complex));
+	for (int n = 0; n < length; n++)
+	{
+		*(czt->work + n) = *(input + n) * *(czt->premultiply + n);
+	}
+	fft_forward(czt->plan, czt->work, czt->work);
+	for (int k = 0; k < czt->size; k++)
+	{
+		*(czt->work + k) *= *(czt->kernel + k);
+	}
+	fft_inverse(czt->plan, czt->work, czt->work);
+	for (int k = 0; k < czt->points; k++)
+	{
+		*(output + k) = *(czt->work + k) * *(czt->postmultiply + k);
+	}
+}
+
+void chirp_z_free(struct ChirpZ *czt)
+{
+	if (czt != NULL)
+	{
+		free(czt->premultiply);
+		free(czt->postmultiply);
+		free(czt->kernel);
+		free(czt->work);
+		free(czt);
+	}
+}
+
+/* Values of a polynomial p[0] + p[1] z^-1 + ... on the grid, and its group delay
+ * Re(sum n p[n] z^-n / sum p[n] z^-n). The whole band is the first half of a transform of
+ * 2 points, with coefficients beyond it folded back, which samples the same response exactly.
+ * polynomial and ramp are scratch of transform size. */
+static void evaluate(const double *coefficients, int length, const struct ResponseGrid *grid, struct ChirpZ *czt, double complex *polynomial, double complex *ramp, double complex *values, double *delay)
+{
+	int size = czt != NULL ? czt->length : 2 * grid->points;
+
+	memset(polynomial, 0, size * sizeof(double complex));
+	memset(ramp, 0, size * sizeof(double complex));
+	for (int n = 0; n < length; n++)
+	{
+		int index = czt != NULL ? n : n % size;
+		*(polynomial + index) += *(coefficients + n);
+		*(ramp + index) += n * *(coefficients + n);
+	}
+
+	if (czt != NULL)
+	{
+		chirp_z_transform(czt, polynomial, length, polynomial);
+		chirp_z_transform(czt, ramp, length, ramp);
+	}
+	else
+	{
+		const struct FftPlan *plan = fft_cached_plan(size);
+		fft_forward(plan, polynomial, polynomial);
+		fft_forward(plan, ramp, ramp);
+	}
+
+	for (int k = 0; k < grid->points; k++)
+	{
+		double complex p = *(polynomial + k);
+		double power = creal(p) * creal(p) + cimag(p) * cimag(p);
+
+		*(values + k) = p;
+		*(delay + k) = power > RESPONSE_DELAY_FLOOR ? creal(*(ramp + k) * conj(p)) / power : 0.0;
+	}
+}
+
+static struct FrequencyResponse *response_alloc(int points)
+{
+	struct FrequencyResponse *response = calloc(1, sizeof(struct FrequencyResponse));
+	double *values = malloc(4 * (size_t) points * sizeof(double));
+	if (response == NULL || values == NULL)
+	{
+		free(response);
+		free(values);
+		return NULL;
+	}
+
+	response->points = points;
+	response->frequency = values;
+	response->magnitude = values + points;
+	response->phase = values + 2 * (size_t) points;
+	response->delay = values + 3 * (size_t) points;
+	return response;
+}
+
+/* Response of FIR taps, or of biquad sections of six coefficients b0 b1 b2 a0 a1 a2 when fir is
+ * 0. A cascade is the product of its sections' responses and the sum of their group delays, each
+ * numerator and denominator evaluated separately, which stays accurate where expanding the
+ * cascade into one polynomial would not. Returns NULL on failure. */
+struct FrequencyResponse *response_create(const double *coefficients, int count, int fir, const struct ResponseGrid *grid)
+{
+	int sections = fir ? 1 : count / 6;
+	int length = fir ? count : 3;
+	if (count < 1 || grid->points < 2 || grid->sample_rate <= 0.0 || (!fir && (sections < 1 || count % 6 != 0)))
+	{
+		return NULL;
+	}
+	if (grid->zoom && (grid->first < 0.0 || grid->last <= grid->first))
+	{
+		return NULL;
+	}
+
+	struct ChirpZ *czt = grid->zoom ? chirp_z_create(length, grid) : NULL;
+	int size = czt != NULL ? czt->size : 2 * grid->points;
+	struct FrequencyResponse *response = response_alloc(grid->points);
+	double complex *response_values = malloc(grid->points * sizeof(double complex));
+	double complex *values = malloc(grid->points * sizeof(double complex));
+	double *delay = malloc(grid->points * sizeof(double));
+	double complex *polynomial = malloc(size * sizeof(double complex));
+	double complex *ramp = malloc(size * sizeof(double complex));
+	int status = (czt != NULL || !grid->zoom) && (grid->zoom || fft_cached_plan(size) != NULL);
+
+	status = status && response != NULL && response_values != NULL && values != NULL && delay != NULL && polynomial != NULL && ramp != NULL;
+	for (int k = 0; status && k < grid->points; k++)
+	{
+		*(response_values + k) = 1.0;
+		*(response->delay + k) = 0.0;
+	}
+
+	for (int s = 0; status && s < sections; s++)
+	{
+		const double *section = coefficients + 6 * s;
+
+		evaluate(fir ? coefficients : section, length, grid, czt, polynomial, ramp, values, delay);
+		for (int k = 0; k < grid->points; k++)
+		{
+			*(response_values + k) *= *(values + k);
+			*(response->delay + k) += *(delay + k);
+		}
+		if (!fir)
+		{
+			evaluate(section + 3, 3, grid, czt, polynomial, ramp, values, delay);
+			for (int k = 0; k < grid->points; k++)
+			{
+				*(response_values + k) /= *(values + k);
+				*(response->delay + k) -= *(delay + k);
+			}
+		}
+	}
+
+	double spacing = grid->zoom ? (grid->last - grid->first) / (grid->points - 1) : grid->sample_rate / (2.0 * grid->points);
+	double previous = 0.0;
+	for (int k = 0; status && k < grid->points; k++)
+	{
+		double complex h = *(response_values + k);
+		double phase = carg(h);
+
+		// Unwrap against the previous point, so the phase is continuous along the grid.
+		phase = k == 0 ? phase : previous + remainder(phase - previous, 2.0 * M_PI);
+		*(response->frequency + k) = (grid->zoom ? grid->first : 0.0) + k * spacing;
+		*(response->magnitude + k) = 20.0 * log10(cabs(h) > 1e-300 ? cabs(h) : 1e-300);
+		*(response->phase + k) = phase;
+		previous = phase;
+	}
+
+	if (!status)
+	{
+		response_free(response);
+		response = NULL;
+	}
+	chirp_z_free(czt);
+	free(response_values);
+	free(values);
+	free(delay);
+	free(polynomial);
+	free(ramp);
+	return response;
+}
+
+void response_free(struct FrequencyResponse *response)
+{
+	if (response != NULL)
+	{
+		free(response->frequency);
+		free(response);
+	}
+}
@@ -0,0 +1,59 @@
+#ifndef RESPONSE
+#define RESPONSE
+
+/************************************************************************************************
+ * FilterTools/response.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Frequency response analysis of FIR taps and biquad cascades. Magnitude, phase
+ * 		  and group delay come from zero padded transforms of the coefficients over the
+ * 		  whole band, or from a chirp-z transform zoomed onto a narrow one.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "../../DFT/src/fft.h"
+
+#define RESPONSE_DEFAULT_POINTS 16384
+
+struct ResponseGrid {
+	double sample_rate;
+	int points;
+	int zoom;		// Evaluate [first, last] by chirp-z, otherwise [0, sample_rate / 2)
+	double first;		// Hz
+	double last;		// Hz
+};
+
+// Evaluates polynomials of up to length coefficients on a zoomed grid.
+struct ChirpZ {
+	int length;
+	int points;
+	int size;			// Convolution length, a power of 2
+	const struct FftPlan *plan;
+	double complex *premultiply;	// A^-n W^(n^2 / 2), n < length
+	double complex *postmultiply;	// W^(k^2 / 2), k < points
+	double complex *kernel;		// Transform of W^(-m^2 / 2) wrapped for negative m
+	double complex *work;
+};
+
+struct FrequencyResponse {
+	int points;
+	double *frequency;	// Hz
+	double *magnitude;	// dB
+	double *phase;		// Radians, unwrapped along the grid
+	double *delay;		// Group delay in samples
+};
+
+struct ChirpZ *chirp_z_create(int length, const struct ResponseGrid *grid);
+void chirp_z_transform(struct ChirpZ *czt, const double complex *input, int length, double complex *output);
+void chirp_z_free(struct ChirpZ *czt);
+
+struct FrequencyResponse *response_create(const double *coefficients, int count, int fir, const struct ResponseGrid *grid);
+void response_free(struct FrequencyResponse *response);
+
+#endif
@@ -15,5 +15,5 @@
 #define OUTPUT_WINDOW_SIZE 20, 80
 #define OUTPUT_WINDOW_LOCATION 13, (COLS - 80) / 2
 
-#define POPUP_WINDOW_SIZE 20, 60
+#define POPUP_WINDOW_SIZE 22, 60
 #define POPUP_WINDOW_LOCATION 10, (COLS - 60) / 2
@@ -0,0 +1,178 @@
+/************************************************************************************************
+ * FilterTools/export_writer.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Export stage. Rendered blocks are handed to a dedicated writer thread
+ * 		  through a ring of EXPORT_RING_SIZE blocks with one producer and one consumer,
+ * 		  so that sample generation and file output overlap.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "export_writer.h"
+#include "noise.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+#define EXPORT_FILE_BUFFER (1 << 20)
+
+/* Q format code of a sample, full scale being 2^fraction_bits. The most positive code is one step
+ * short of +1, so the range is clipped asymmetrically as on fixed point targets. */
+long export_quantise(long double x, int fraction_bits, long double dither)
+{
+	long double scale = ldexpl(1.0L, fraction_bits);
+	long double level = x * scale + dither;
+
+	if (level > scale - 1.0L)
+	{
+		level = scale - 1.0L;
+	}
+	else if (level < -scale)
+	{
+		level = -scale;
+	}
+	return lrintl(level);
+}
+
+static void write_block(struct ExportWriter *writer, const struct ExportBlock *block)
+{
+	const long double *frame = block->samples;
+
+	for (int i = 0; i < block->count; i++)
+	{
+		fprintf(writer->fp, "%Lf", (block->start + i) * writer->sample_period);
+		for (int channel = 0; channel < writer->channels; channel++)
+		{
+			if (writer->fraction_bits > 0)
+			{
+				long n = (long) (block->start + i) * writer->channels + channel;
+				long double dither = writer->dither ? noise_tpdf(writer->dither_seed, n) : 0.0L;
+				fprintf(writer->fp, ", %ld", export_quantise(*frame++, writer->fraction_bits, dither));
+			}
+			else
+			{
+				fprintf(writer->fp, ", %Lf", *frame++);
+			}
+		}
+		fputc('\n', writer->fp);
+	}
+}
+
+/* Sleeps until a block is committed, writes it outside the lock and hands it back. Exits once the
+ * producer has finished and every committed block is written. */
+static void *writer_thread(void *arg)
+{
+	struct ExportWriter *writer = arg;
+
+	pthread_mutex_lock(&writer->lock);
+	while (1)
+	{
+		while (writer->tail == writer->head && !writer->finished)
+		{
+			pthread_cond_wait(&writer->filled, &writer->lock);
+		}
+		if (writer->tail == writer->head)
+		{
+			break;
+		}
+
+		struct ExportBlock *block = &writer->ring[writer->tail & (EXPORT_RING_SIZE - 1)];
+		pthread_mutex_unlock(&writer->lock);
+		write_block(writer, block);
+		pthread_mutex_lock(&writer->lock);
+		writer->tail++;
+		pthread_cond_signal(&writer->drained);
+	}
+	pthread_mutex_unlock(&writer->lock);
+
+	return NULL;
+}
+
+static void free_writer(struct ExportWriter *writer)
+{
+	pthread_mutex_destroy(&writer->lock);
+	pthread_cond_destroy(&writer->filled);
+	pthread_cond_destroy(&writer->drained);
+	for (int i = 0; i < EXPORT_RING_SIZE; i++)
+	{
+		free(writer->ring[i].samples);
+	}
+	free(writer);
+}
+
+struct ExportWriter *export_writer_start(FILE *fp, long double sample_period, int channels, int fraction_bits, int dither)
+{
+	struct ExportWriter *writer = calloc(1, sizeof(struct ExportWriter));
+	if (writer == NULL)
+	{
+		return NULL;
+	}
+
+	pthread_mutex_init(&writer->lock, NULL);
+	pthread_cond_init(&writer->filled, NULL);
+	pthread_cond_init(&writer->drained, NULL);
+	for (int i = 0; i < EXPORT_RING_SIZE; i++)
+	{
+		writer->ring[i].samples = malloc(channels * EXPORT_BLOCK_SIZE * sizeof(long double));
+		if (writer->ring[i].samples == NULL)
+		{
+			free_writer(writer);
+			return NULL;
+		}
+	}
+
+	writer->fp = fp;
+	writer->sample_period = sample_period;
+	writer->channels = channels;
+	writer->fraction_bits = fraction_bits;
+	writer->dither = dither && fraction_bits > 0;
+	writer->dither_seed = 0;
+	setvbuf(fp, NULL, _IOFBF, EXPORT_FILE_BUFFER);
+
+	if (pthread_create(&writer->thread, NULL, &writer_thread, writer) != 0)
+	{
+		free_writer(writer);
+		return NULL;
+	}
+
+	return writer;
+}
+
+// Returns the next free block, sleeping until the writer frees one if the ring is full.
+struct ExportBlock *export_writer_acquire(struct ExportWriter *writer)
+{
+	pthread_mutex_lock(&writer->lock);
+	while (writer->head - writer->tail >= EXPORT_RING_SIZE)
+	{
+		pthread_cond_wait(&writer->drained, &writer->lock);
+	}
+	struct ExportBlock *block = &writer->ring[writer->head & (EXPORT_RING_SIZE - 1)];
+	pthread_mutex_unlock(&writer->lock);
+
+	return block;
+}
+
+void export_writer_commit(struct ExportWriter *writer)
+{
+	pthread_mutex_lock(&writer->lock);
+	writer->head++;
+	pthread_cond_signal(&writer->filled);
+	pthread_mutex_unlock(&writer->lock);
+}
+
+// Drains remaining blocks and releases the writer. The file is left open for the caller.
+void export_writer_finish(struct ExportWriter *writer)
+{
+	pthread_mutex_lock(&writer->lock);
+	writer->finished = 1;
+	pthread_cond_signal(&writer->filled);
+	pthread_mutex_unlock(&writer->lock);
+	pthread_join(writer->thread, NULL);
+	free_writer(writer);
+}
@@ -0,0 +1,55 @@
+#ifndef EXPORT_WRITER
+#define EXPORT_WRITER
+
+/************************************************************************************************
+ * FilterTools/export_writer.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Export stage. Rendered blocks are handed to a dedicated writer thread
+ * 		  through a ring of EXPORT_RING_SIZE blocks with one producer and one consumer,
+ * 		  so that sample generation and file output overlap.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <stdio.h>
+#include <pthread.h>
+
+#define EXPORT_BLOCK_SIZE 4096	// Frames per block
+#define EXPORT_RING_SIZE 8	// Must be a power of 2
+
+struct ExportBlock {
+	int start;	// Index of first frame in block
+	int count;
+	long double *samples;	// Interleaved frames, one sample per channel
+};
+
+struct ExportWriter {
+	FILE *fp;
+	long double sample_period;
+	int channels;
+	int fraction_bits;	// 15 or 31 writes Q format integer codes, 0 writes values
+	int dither;		// TPDF dither on Q format codes
+	unsigned long dither_seed;
+	struct ExportBlock ring[EXPORT_RING_SIZE];
+	unsigned int head;	// Next block to be filled by producer
+	unsigned int tail;	// Next block to be drained by writer
+	int finished;
+	pthread_mutex_t lock;	// Guards head, tail and finished
+	pthread_cond_t filled;	// Signalled when a block is committed or the producer finishes
+	pthread_cond_t drained;	// Signalled when the writer frees a block
+	pthread_t thread;
+};
+
+struct ExportWriter *export_writer_start(FILE *fp, long double sample_period, int channels, int fraction_bits, int dither);
+long export_quantise(long double x, int fraction_bits, long double dither);
+struct ExportBlock *export_writer_acquire(struct ExportWriter *writer);
+void export_writer_commit(struct ExportWriter *writer);
+void export_writer_finish(struct ExportWriter *writer);
+
+#endif
@@ -35,6 +35,11 @@ static struct WaveList waves = {
 	.export_path = export_path,
 	.sample_count = 1000,
 	.sample_frequency = 48000.00,
+	.channel_count = 1,
+	.dither = 1,
+	.tile_periodic = 1,
+	.cache_layers = 1,
+	.wavetable = 1,
 	.first = NULL,
 	.selected = NULL
 };
@@ -92,7 +97,7 @@ void initialise_forms()
 void main_menu_refresh()
 {
     wattron(output_window, A_REVERSE);
-    mvwprintw(output_window, 1, 2, "Samples: %d Sampling Frequency: %.2f", waves.sample_count, waves.sample_frequency);
+    mvwprintw(output_window, 1, 2, "Samples: %d Sampling Frequency: %.2f Channels: %d", waves.sample_count, waves.sample_frequency, waves.channel_count);
     mvwprintw(output_window, 2, 2, "Shape:     Amplitude:  Frequency:  Phase:    Duty:     DC Offset:         ");
   
     struct WaveForm *wave = waves.first;
@@ -182,10 +187,17 @@ int main_menu_driver()
 				update_panels();
 				doupdate();
                 
-                if (form_menu_driver(settings_window, &main_settings_form))
+                // The form stays open until its values are accepted or it is cancelled.
+                int accepted = 0;
+                while (!accepted && form_menu_driver(settings_window, &main_settings_form))
                 {
-                    get_main_settings_fields(&main_settings_form, &waves);
+                    accepted = get_main_settings_fields(&main_settings_form, &waves);
+                    if (!accepted)
+                    {
+                        mvwprintw(settings_window, 16, 4, "Channels must be 1 to %d and cover every wave", WAVE_MAX_CHANNELS);
+                    }
                 }
+                mvwprintw(settings_window, 16, 4, "%52s", "");
 
 				hide_panel(settings_panel);
 				update_panels();
@@ -200,10 +212,21 @@ int main_menu_driver()
 					update_panels();
 					doupdate();
 
-			        if (form_menu_driver(wave_settings_window, &wave_form))
-				{
-					get_wave_fields(&wave_form, waves.selected);
-				}
+					// The form stays open until its values are accepted or it is cancelled.
+					int accepted = 0;
+					while (!accepted && form_menu_driver(wave_settings_window, &wave_form))
+					{
+						accepted = get_wave_fields(&wave_form, waves.selected, waves.channel_count);
+						if (!accepted)
+						{
+							mvwprintw(wave_settings_window, 20, 4, "Channel 0 to %d", waves.channel_count);
+						}
+					}
+					mvwprintw(wave_settings_window, 20, 4, "%20s", "");
+					if (accepted)
+					{
+						invalidate_wave_cache(waves.selected);
+					}
 
 				hide_panel(wave_settings_panel);
 				update_panels();
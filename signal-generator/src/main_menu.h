@@ -21,7 +21,7 @@ extern const char *const wave_modes[];
 #define OUTPUT_WINDOW_SIZE 20, 80
 #define OUTPUT_WINDOW_LOCATION 13, (COLS - 80) / 2
 
-#define POPUP_WINDOW_SIZE 20, 60
+#define POPUP_WINDOW_SIZE 22, 60
 #define POPUP_WINDOW_LOCATION 10, (COLS - 60) / 2
 
 void initialise_ncurses();
@@ -17,35 +17,48 @@
 #include <stdlib.h>
 #include <string.h>
 
+const char *const export_formats[] = EXPORT_FORMAT_MENU; // GLOBAL
+static struct Dropdown format_dropdown = { 0, &export_formats[0], sizeof export_formats / sizeof export_formats[0] };
+
 struct Form main_settings_setup (WINDOW *window)
 {
 	mvwprintw(window, 2, 4, "Export Path:");
 	mvwprintw(window, 4, 4, "Sampling Frequency:");
 	mvwprintw(window, 4, 36, "Hz");
     mvwprintw(window, 6, 4, "Number of Samples:");
+    mvwprintw(window, 8, 4, "Channels:");
+    mvwprintw(window, 10, 4, "Format:");
+    mvwprintw(window, 12, 4, "Dither (0 off):");
 	
 	static enum FieldType types[] = { 
 		PATH_FIELD, 
 		NUMBER_FIELD, 
 		INDEX_FIELD,
+		INDEX_FIELD,
+		LIST_FIELD,
+		INDEX_FIELD,
         OK_FIELD,
         CANCEL_FIELD
 	};
 	
 	struct Form settings;
-	settings.field_count = 6;
+	settings.field_count = 8;
 	settings.fields = calloc(settings.field_count + 1, sizeof(FIELD *));
 	settings.field_types = &types[0];
         
 	settings.fields[0] = new_field(1, 20, 0, 0, 0, 0);
 	settings.fields[1] = new_field(1, 20, 2, 0, 0, 0);
 	settings.fields[2] = new_field(1, 20, 4, 0, 0, 0);
-	settings.fields[3] = new_field(1, 8, 6, 0, 0, 0);
-	settings.fields[4] = new_field(1, 8, 6, 10, 0, 0);
-	settings.fields[5] = NULL;
+	settings.fields[3] = new_field(1, 20, 6, 0, 0, 0);
+	settings.fields[4] = new_field(1, 20, 8, 0, 0, 0);
+	settings.fields[5] = new_field(1, 20, 10, 0, 0, 0);
+	settings.fields[6] = new_field(1, 8, 12, 0, 0, 0);
+	settings.fields[7] = new_field(1, 8, 12, 10, 0, 0);
+	settings.fields[8] = NULL;
     
-	set_field_buffer(settings.fields[3], 0, "   Ok   ");
-	set_field_buffer(settings.fields[4], 0, " Cancel ");
+	set_field_userptr(settings.fields[4], (void *) &format_dropdown);
+	set_field_buffer(settings.fields[6], 0, "   Ok   ");
+	set_field_buffer(settings.fields[7], 0, " Cancel ");
     	
 	field_setup(settings.fields, types, settings.field_count);
 	settings.form = form_setup(window, settings.fields, 8, 28);
@@ -56,19 +69,46 @@ struct Form main_settings_setup (WINDOW *window)
 void set_main_settings_fields(const struct Form *main_settings, const struct WaveList *list)
 {   
     char temp[21];
+    struct Dropdown *drop_down;
     set_field_buffer(main_settings->fields[0], 0, list->export_path);
     sprintf(temp, "%e", list->sample_frequency);
     set_field_buffer(main_settings->fields[1], 0, temp);
     sprintf(temp, "%d", list->sample_count);
     set_field_buffer(main_settings->fields[2], 0, temp);
+    sprintf(temp, "%d", list->channel_count);
+    set_field_buffer(main_settings->fields[3], 0, temp);
+    drop_down = (struct Dropdown *) field_userptr(main_settings->fields[4]);
+    drop_down->index = list->export_format;
+    set_field_buffer(main_settings->fields[4], 0, export_formats[drop_down->index]);
+    sprintf(temp, "%d", list->dither);
+    set_field_buffer(main_settings->fields[5], 0, temp);
 }
 
-void get_main_settings_fields(const struct Form *main_settings, struct WaveList *list)
+/* Returns 0 and leaves the list unchanged if the channel count is outside 1 to WAVE_MAX_CHANNELS
+ * or below the channel of any wave, whose output would otherwise be dropped from the mix. */
+int get_main_settings_fields(const struct Form *main_settings, struct WaveList *list)
 {
     char temp[21];
+    strip_whitespace(field_buffer(main_settings->fields[3], 0), temp);
+    int channel_count = ASCII_string_to_double(temp);
+    for (struct WaveForm *wave = list->first; wave != NULL; wave = wave->next)
+    {
+	channel_count = wave->channel > channel_count ? 0 : channel_count;
+    }
+    if (channel_count < 1 || channel_count > WAVE_MAX_CHANNELS)
+    {
+	return 0;
+    }
+
     strcpy(list->export_path, field_buffer(main_settings->fields[0], 0));
     strip_whitespace(field_buffer(main_settings->fields[1], 0), temp);
     list->sample_frequency = ASCII_string_to_double(temp);
     strip_whitespace(field_buffer(main_settings->fields[2], 0), temp);
     list->sample_count = ASCII_string_to_double(temp);
+    list->channel_count = channel_count;
+    struct Dropdown *drop_down = (struct Dropdown *) field_userptr(main_settings->fields[4]);
+    list->export_format = drop_down->index;
+    strip_whitespace(field_buffer(main_settings->fields[5], 0), temp);
+    list->dither = ASCII_string_to_double(temp);
+    return 1;
 }
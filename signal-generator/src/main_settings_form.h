@@ -20,6 +20,6 @@
 
 struct Form main_settings_setup (WINDOW *window);
 void set_main_settings_fields(const struct Form *main_settings, const struct WaveList *list);
-void get_main_settings_fields(const struct Form *main_settings, struct WaveList *list);
+int get_main_settings_fields(const struct Form *main_settings, struct WaveList *list);
 
 #endif 
@@ -0,0 +1,152 @@
+/************************************************************************************************
+ * FilterTools/noise.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Counter based noise generators. Every sample is a pure function of the seed
+ * 		  and the sample index, so any block renders identically in any order or thread.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "noise.h"
+
+#include <stdint.h>
+#include <math.h>
+
+#define NOISE_CHUNK 256
+
+/* Stream numbers keep each generator independent for the same seed. Pink rows take
+ * NOISE_PINK_ROWS consecutive streams, so they come last. */
+enum NoiseStream { NOISE_STREAM_WHITE, NOISE_STREAM_GAUSSIAN, NOISE_STREAM_TPDF, NOISE_STREAM_PINK };
+
+// SplitMix64 finaliser, a bijective mix of all 64 input bits.
+static uint64_t mix64(uint64_t x)
+{
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBULL;
+	x ^= x >> 31;
+	return x;
+}
+
+// Random 64 bit value for position n of a stream.
+static uint64_t counter_hash(uint64_t stream, uint64_t n)
+{
+	return mix64(stream + n * 0x9E3779B97F4A7C15ULL);
+}
+
+static uint64_t stream_key(unsigned long seed, uint64_t stream)
+{
+	return mix64(mix64((uint64_t) seed) ^ (stream * 0xD1B54A32D192ED03ULL));
+}
+
+// Uniform in [-1, 1)
+static double uniform(uint64_t bits)
+{
+	return (bits >> 11) * 0x1.0p-52 - 1.0;
+}
+
+void noise_white(unsigned long seed, long start, long count, long double *output)
+{
+	uint64_t key = stream_key(seed, NOISE_STREAM_WHITE);
+
+	for (long i = 0; i < count; i++)
+	{
+		*(output + i) = uniform(counter_hash(key, start + i));
+	}
+}
+
+/* Unit variance. Box-Muller on two counter values per sample keeps every sample independent of
+ * its neighbours, unlike rejection methods such as the ziggurat. */
+void noise_gaussian(unsigned long seed, long start, long count, long double *output)
+{
+	uint64_t key = stream_key(seed, NOISE_STREAM_GAUSSIAN);
+
+	for (long i = 0; i < count; i++)
+	{
+		uint64_t n = 2 * (uint64_t) (start + i);
+		double radius = ((counter_hash(key, n) >> 11) + 1) * 0x1.0p-53;	// (0, 1]
+		double angle = (counter_hash(key, n + 1) >> 11) * 0x1.0p-53;
+		*(output + i) = sqrt(-2.0 * log(radius)) * cos(2.0 * M_PI * angle);
+	}
+}
+
+/* Voss algorithm: row k holds a uniform value that changes every 2^k samples. The value of a row
+ * is hashed from its hold index, so no running state is needed. Peak amplitude is 1. */
+void noise_pink(unsigned long seed, long start, long count, long double *output)
+{
+	uint64_t keys[NOISE_PINK_ROWS];
+	for (int k = 0; k < NOISE_PINK_ROWS; k++)
+	{
+		keys[k] = stream_key(seed, NOISE_STREAM_PINK + k);
+	}
+
+	for (long i = 0; i < count; i++)
+	{
+		uint64_t n = start + i;
+		double sum = 0.0;
+		for (int k = 0; k < NOISE_PINK_ROWS; k++)
+		{
+			sum += uniform(counter_hash(keys[k], n >> k));
+		}
+		*(output + i) = sum / NOISE_PINK_ROWS;
+	}
+}
+
+/* Blackman windowed sinc lowpass for band limited noise, cutoff in cycles per sample. Taps are
+ * normalised to unit energy so the output keeps unit variance. */
+void noise_band_taps(double cutoff, double *taps)
+{
+	double energy = 0.0;
+	int centre = NOISE_BAND_TAPS / 2;
+
+	cutoff = fmin(fabs(cutoff), 0.5);
+	for (int k = 0; k < NOISE_BAND_TAPS; k++)
+	{
+		double x = k - centre;
+		double window = 0.42 - 0.5 * cos(2.0 * M_PI * k / (NOISE_BAND_TAPS - 1)) + 0.08 * cos(4.0 * M_PI * k / (NOISE_BAND_TAPS - 1));
+		*(taps + k) = window * (x == 0.0 ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * x) / (M_PI * x));
+		energy += *(taps + k) * *(taps + k);
+	}
+	for (int k = 0; k < NOISE_BAND_TAPS; k++)
+	{
+		*(taps + k) = energy > 0.0 ? *(taps + k) / sqrt(energy) : 0.0;
+	}
+}
+
+// Gaussian noise through taps from noise_band_taps(), designed once per cutoff rather than per block.
+void noise_band_limited(unsigned long seed, const double *taps, long start, long count, long double *output)
+{
+	long double white[NOISE_CHUNK + NOISE_BAND_TAPS - 1];
+	for (long i = 0; i < count; i += NOISE_CHUNK)
+	{
+		long length = count - i < NOISE_CHUNK ? count - i : NOISE_CHUNK;
+
+		// Input history reaches back NOISE_BAND_TAPS - 1 samples before the chunk.
+		noise_gaussian(seed, start + i - (NOISE_BAND_TAPS - 1), length + NOISE_BAND_TAPS - 1, white);
+		for (long j = 0; j < length; j++)
+		{
+			long double sum = 0.0L;
+			for (int k = 0; k < NOISE_BAND_TAPS; k++)
+			{
+				sum += *(taps + k) * white[j + NOISE_BAND_TAPS - 1 - k];
+			}
+			*(output + i + j) = sum;
+		}
+	}
+}
+
+// Triangular on (-1, 1), the mean of two independent uniform values for position n. Used as TPDF dither.
+long double noise_tpdf(unsigned long seed, long n)
+{
+	uint64_t key = stream_key(seed, NOISE_STREAM_TPDF);
+	uint64_t index = 2 * (uint64_t) n;
+
+	return 0.5 * (uniform(counter_hash(key, index)) + uniform(counter_hash(key, index + 1)));
+}
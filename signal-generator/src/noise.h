@@ -0,0 +1,29 @@
+#ifndef NOISE
+#define NOISE
+
+/************************************************************************************************
+ * FilterTools/noise.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Counter based noise generators. Every sample is a pure function of the seed
+ * 		  and the sample index, so any block renders identically in any order or thread.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#define NOISE_PINK_ROWS 16
+#define NOISE_BAND_TAPS 63	// Odd, lowpass FIR length for band limited noise
+
+void noise_white(unsigned long seed, long start, long count, long double *output);
+void noise_gaussian(unsigned long seed, long start, long count, long double *output);
+void noise_pink(unsigned long seed, long start, long count, long double *output);
+void noise_band_taps(double cutoff, double *taps);
+void noise_band_limited(unsigned long seed, const double *taps, long start, long count, long double *output);
+long double noise_tpdf(unsigned long seed, long n);
+
+#endif
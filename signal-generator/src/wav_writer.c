@@ -0,0 +1,171 @@
+/************************************************************************************************
+ * FilterTools/wav_writer.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: WAV export through a pre-sized memory mapped file. Samples are quantised
+ * 		  straight into the mapping as they are rendered.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "wav_writer.h"
+#include "noise.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define WAV_HEADER_SIZE 44
+#define WAV_FORMAT_PCM 1
+#define WAV_FORMAT_FLOAT 3
+
+static unsigned char *put_le(unsigned char *p, uint32_t value, int bytes)
+{
+	for (int i = 0; i < bytes; i++)
+	{
+		*p++ = (value >> (8 * i)) & 0xFF;
+	}
+	return p;
+}
+
+static void write_header(struct WavFile *wav, double sample_rate)
+{
+	uint32_t data_size = wav->size - WAV_HEADER_SIZE;
+	uint32_t block_align = wav->channels * wav->bytes_per_sample;
+	unsigned char *p = wav->map;
+
+	memcpy(p, "RIFF", 4);
+	p = put_le(p + 4, wav->size - 8, 4);
+	memcpy(p, "WAVEfmt ", 8);
+	p = put_le(p + 8, 16, 4);
+	p = put_le(p, wav->format == WAV_FLOAT32 ? WAV_FORMAT_FLOAT : WAV_FORMAT_PCM, 2);
+	p = put_le(p, wav->channels, 2);
+	p = put_le(p, (uint32_t) lrint(sample_rate), 4);
+	p = put_le(p, (uint32_t) lrint(sample_rate) * block_align, 4);
+	p = put_le(p, block_align, 2);
+	p = put_le(p, 8 * wav->bytes_per_sample, 2);
+	memcpy(p, "data", 4);
+	put_le(p + 4, data_size, 4);
+}
+
+/* Creates the file at its final size and maps it. Returns NULL if the file could not be created or
+ * would exceed the 4 GiB RIFF limit. */
+struct WavFile *wav_open(const char *path, int channels, double sample_rate, long frames, enum WavSampleFormat format, int dither)
+{
+	static const int sample_bytes[] = { [WAV_INT16] = 2, [WAV_INT24] = 3, [WAV_FLOAT32] = 4 };
+	size_t size = WAV_HEADER_SIZE + (size_t) frames * channels * sample_bytes[format];
+
+	if (size > UINT32_MAX)
+	{
+		printf("WAV export too large.\n");
+		return NULL;
+	}
+
+	struct WavFile *wav = calloc(1, sizeof(struct WavFile));
+	if (wav == NULL)
+	{
+		return NULL;
+	}
+
+	wav->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (wav->fd < 0)
+	{
+		free(wav);
+		return NULL;
+	}
+	if (ftruncate(wav->fd, size) != 0)
+	{
+		close(wav->fd);
+		free(wav);
+		return NULL;
+	}
+
+	wav->map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, wav->fd, 0);
+	if (wav->map == MAP_FAILED)
+	{
+		close(wav->fd);
+		free(wav);
+		return NULL;
+	}
+	madvise(wav->map, size, MADV_SEQUENTIAL);
+
+	wav->size = size;
+	wav->data = wav->map + WAV_HEADER_SIZE;
+	wav->channels = channels;
+	wav->frames = frames;
+	wav->format = format;
+	wav->bytes_per_sample = sample_bytes[format];
+	wav->dither = dither && format != WAV_FLOAT32;
+	wav->dither_seed = 0;
+	write_header(wav, sample_rate);
+
+	return wav;
+}
+
+static uint32_t quantise(const long double x, const long double full_scale, const long double dither)
+{
+	long double level = x * full_scale + dither;
+	long double limit = full_scale + 1.0L;	// Two's complement allows one extra negative step
+
+	if (level > full_scale)
+	{
+		level = full_scale;
+	}
+	else if (level < -limit)
+	{
+		level = -limit;
+	}
+	return (uint32_t) (int32_t) lrintl(level);
+}
+
+/* Stores frames [start, start + count) from planar channel sources, interleaving and quantising in
+ * one pass. Samples are full scale at +/-1 and clipped beyond it. A NULL source is silent. */
+void wav_store(struct WavFile *wav, long start, const long double *const *sources, long count)
+{
+	long double full_scale = wav->format == WAV_INT16 ? 32767.0L : 8388607.0L;
+
+	for (int channel = 0; channel < wav->channels; channel++)
+	{
+		const long double *source = sources[channel];
+		unsigned char *p = wav->data + ((size_t) start * wav->channels + channel) * wav->bytes_per_sample;
+		size_t stride = (size_t) wav->channels * wav->bytes_per_sample;
+
+		for (long i = 0; i < count; i++, p += stride)
+		{
+			long double x = source != NULL ? *(source + i) : 0.0L;
+
+			if (wav->format == WAV_FLOAT32)
+			{
+				float value = (float) x;
+				uint32_t bits;
+				memcpy(&bits, &value, sizeof(bits));
+				put_le(p, bits, 4);
+			}
+			else
+			{
+				long n = (start + i) * wav->channels + channel;
+				long double dither = wav->dither ? noise_tpdf(wav->dither_seed, n) : 0.0L;
+				put_le(p, quantise(x, full_scale, dither), wav->bytes_per_sample);
+			}
+		}
+	}
+}
+
+int wav_close(struct WavFile *wav)
+{
+	int status = munmap(wav->map, wav->size) == 0;
+
+	status = close(wav->fd) == 0 && status;
+	free(wav);
+	return status;
+}
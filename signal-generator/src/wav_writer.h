@@ -0,0 +1,40 @@
+#ifndef WAV_WRITER
+#define WAV_WRITER
+
+/************************************************************************************************
+ * FilterTools/wav_writer.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: WAV export through a pre-sized memory mapped file. Samples are quantised
+ * 		  straight into the mapping as they are rendered.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include <stddef.h>
+
+enum WavSampleFormat { WAV_INT16, WAV_INT24, WAV_FLOAT32 };
+
+struct WavFile {
+	int fd;
+	unsigned char *map;
+	size_t size;
+	unsigned char *data;	// First byte of sample data
+	int channels;
+	long frames;
+	enum WavSampleFormat format;
+	int bytes_per_sample;
+	int dither;		// TPDF dither on integer formats
+	unsigned long dither_seed;
+};
+
+struct WavFile *wav_open(const char *path, int channels, double sample_rate, long frames, enum WavSampleFormat format, int dither);
+void wav_store(struct WavFile *wav, long start, const long double *const *sources, long count);
+int wav_close(struct WavFile *wav);
+
+#endif
@@ -34,6 +34,9 @@ struct Form wave_settings_setup (WINDOW *window)
 	mvwprintw(window, 10, 4, "Duty:");
 	mvwprintw(window, 12, 4, "Mode:");
 	mvwprintw(window, 14, 4, "DC Offset:");
+	mvwprintw(window, 16, 4, "Stop Frequency:");
+	mvwprintw(window, 16, 36, "Hz");
+	mvwprintw(window, 18, 4, "Channel (0 all):");
 	
 	static enum FieldType types[] = { 
 		LIST_FIELD, 
@@ -43,12 +46,14 @@ struct Form wave_settings_setup (WINDOW *window)
 		NUMBER_FIELD, 
 		LIST_FIELD, 
 		NUMBER_FIELD, 
+		NUMBER_FIELD, 
+		INDEX_FIELD, 
 		OK_FIELD, 
 		CANCEL_FIELD 
 	};
 	
 	struct Form settings;
-	settings.field_count = 9;
+	settings.field_count = 11;
 	settings.fields = calloc(settings.field_count + 1, sizeof(FIELD *));
 	settings.field_types = &types[0];
         
@@ -59,14 +64,16 @@ struct Form wave_settings_setup (WINDOW *window)
 	settings.fields[4] = new_field(1, 20, 8, 0, 0, 0);
 	settings.fields[5] = new_field(1, 20, 10, 0, 0, 0);
 	settings.fields[6] = new_field(1, 20, 12, 0, 0, 0);
-	settings.fields[7] = new_field(1, 8, 14, 0, 0, 0);
-	settings.fields[8] = new_field(1, 8, 14, 10, 0, 0);
-	settings.fields[9] = NULL;
+	settings.fields[7] = new_field(1, 20, 14, 0, 0, 0);
+	settings.fields[8] = new_field(1, 20, 16, 0, 0, 0);
+	settings.fields[9] = new_field(1, 8, 18, 0, 0, 0);
+	settings.fields[10] = new_field(1, 8, 18, 10, 0, 0);
+	settings.fields[11] = NULL;
     
 	set_field_userptr(settings.fields[0], (void *) &settings_dropdowns[0]);
 	set_field_userptr(settings.fields[5], (void *) &settings_dropdowns[1]);
-	set_field_buffer(settings.fields[7], 0, "   Ok   ");
-	set_field_buffer(settings.fields[8], 0, " Cancel ");
+	set_field_buffer(settings.fields[9], 0, "   Ok   ");
+	set_field_buffer(settings.fields[10], 0, " Cancel ");
     	
 	field_setup(settings.fields, types, settings.field_count);
 	settings.form = form_setup(window, settings.fields, 8, 28);
@@ -95,11 +102,23 @@ void set_wave_fields(const struct Form *wave_settings, const struct WaveForm *wa
     set_field_buffer((wave_settings->fields)[5], 0, wave_modes[drop_down->index]);
     sprintf(temp, "%e", wave->dc_offset);
     set_field_buffer(wave_settings->fields[6], 0, temp);
+    sprintf(temp, "%e", wave->stop_frequency);
+    set_field_buffer(wave_settings->fields[7], 0, temp);
+    sprintf(temp, "%d", wave->channel);
+    set_field_buffer(wave_settings->fields[8], 0, temp);
 }
 
-void get_wave_fields(const struct Form *form, struct WaveForm *wave)
+// Returns 0 and leaves the wave unchanged if its channel is outside 0 to channel_count.
+int get_wave_fields(const struct Form *form, struct WaveForm *wave, int channel_count)
 {
     char temp[21];
+    strip_whitespace(field_buffer(form->fields[8], 0), temp);
+    int channel = ASCII_string_to_double(temp);
+    if (channel < 0 || channel > channel_count)
+    {
+	return 0;
+    }
+
     struct Dropdown *drop_down = (struct Dropdown *) field_userptr(form->fields[0]);
     
     wave->type = drop_down->index;
@@ -118,4 +137,8 @@ void get_wave_fields(const struct Form *form, struct WaveForm *wave)
     
     strip_whitespace(field_buffer(form->fields[6], 0), temp);
     wave->dc_offset = ASCII_string_to_double(temp);
+    strip_whitespace(field_buffer(form->fields[7], 0), temp);
+    wave->stop_frequency = ASCII_string_to_double(temp);
+    wave->channel = channel;
+    return 1;
 }
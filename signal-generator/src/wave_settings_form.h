@@ -20,6 +20,6 @@
 
 struct Form wave_settings_setup (WINDOW *window);
 void set_wave_fields(const struct Form *wave_settings, const struct WaveForm *wave);
-void get_wave_fields(const struct Form *form, struct WaveForm *wave);
+int get_wave_fields(const struct Form *form, struct WaveForm *wave, int channel_count);
 
 #endif 
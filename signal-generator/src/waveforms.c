@@ -13,16 +13,96 @@
  ************************************************************************************************ */
 
 #include "waveforms.h"
+#include "export_writer.h"
+#include "wavetable.h"
+#include "noise.h"
+#include "wav_writer.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
-typedef long double (WaveGenerator)(const long double t, const struct WaveForm *wave);
-typedef void (WaveOperation)(WaveGenerator *f, const long double t, const struct WaveForm *wave, long double *output);
+#define RENDER_CHUNK 256
+#define PERIOD_MAX_SAMPLES (1L << 20)
+#define PERIOD_MAX_DENOMINATOR 100000L
+#define PERIOD_TOLERANCE 1e-12L
+
+typedef void (WaveOperation)(struct WaveForm *wave, const int slot, const long double T, const long start, const long count, long double *output);
+typedef void (SampleOperation)(const long double *samples, long double *output, const long count);
+
+static long double sine_shape(const long double cycle, const struct WaveForm *wave)
+{
+	return wave->amplitude * sinl(2.0L * acosl(-1) * cycle) + wave->dc_offset;
+}
+
+static long double cosine_shape(const long double cycle, const struct WaveForm *wave)
+{
+	return wave->amplitude * cosl(2.0L * acosl(-1) * cycle) + wave->dc_offset;
+}
+
+static long double saw_shape(const long double cycle, const struct WaveForm *wave)
+{
+	if (wave->wavetable != NULL)
+	{
+		long double shifted = cycle < 0.5L ? cycle + 0.5L : cycle - 0.5L;
+		return 2.0L * wave->amplitude * wavetable_read(wave->wavetable, shifted) + wave->dc_offset;
+	}
+
+	long double position = cycle < 0.5L ? cycle : cycle - 1.0L;
+
+	return 2.0L * wave->amplitude * position + wave->dc_offset;
+}
+
+static long double triangle_shape(const long double cycle, const struct WaveForm *wave)
+{
+	if (wave->wavetable != NULL)
+	{
+		return wave->amplitude * wavetable_read(wave->wavetable, cycle) + wave->dc_offset;
+	}
+
+	long double output_point = 4.0L * wave->amplitude * cycle;
+	if (cycle >= 0.75L)
+	{
+		output_point -= 4.0L * wave->amplitude;
+	}
+	else if (cycle >= 0.25L)
+	{
+		output_point = 2.0L * wave->amplitude - output_point;
+	}
+
+	return output_point + wave->dc_offset;
+}
+
+// Band limited square is the difference of two ramps offset by the duty cycle.
+static long double square_shape(const long double cycle, const struct WaveForm *wave)
+{
+	if (wave->wavetable != NULL)
+	{
+		long double delayed = cycle - wave->duty;
+		delayed -= floorl(delayed);
+		long double output_point = 2.0L * (wavetable_read(wave->wavetable, delayed) - wavetable_read(wave->wavetable, cycle));
+		return wave->amplitude * (output_point + 2.0L * wave->duty - 1.0L) + wave->dc_offset;
+	}
+
+	return (cycle < wave->duty ? wave->amplitude : -wave->amplitude) + wave->dc_offset;
+}
+
+// Position within the cycle [0, 1) at time t.
+static long double wave_cycle(const long double t, const struct WaveForm *wave)
+{
+	long double cycle = wave->frequency * t + wave->phase / 360.0L;
+
+	return cycle - floorl(cycle);
+}
 
 static long double saw_wave(const long double t, const struct WaveForm *wave)
 {
+	if (wave->wavetable != NULL)
+	{
+		return saw_shape(wave_cycle(t, wave), wave);
+	}
+
 	long double delay = wave->phase / (wave->frequency * 360);
 	long double output_point = 2.0L * wave->amplitude * wave->frequency * (t + delay) + wave->amplitude;
 	output_point = fmodl(output_point, 2.0L * wave->amplitude) - wave->amplitude;
@@ -36,6 +116,11 @@ static long double saw_wave(const long double t, const struct WaveForm *wave)
 
 static long double triangle_wave(const long double t, const struct WaveForm *wave)
 {
+	if (wave->wavetable != NULL)
+	{
+		return triangle_shape(wave_cycle(t, wave), wave);
+	}
+
 	long double delay = wave->phase / (wave->frequency * 360);
 	long double output_point = 4.0L * wave->amplitude * wave->frequency * (t + delay);
 	output_point = fmodl(output_point, 4.0L * wave->amplitude);
@@ -57,6 +142,11 @@ static long double triangle_wave(const long double t, const struct WaveForm *wav
 
 static long double square_wave(const long double t, const struct WaveForm *wave)
 {
+	if (wave->wavetable != NULL)
+	{
+		return square_shape(wave_cycle(t, wave), wave);
+	}
+
 	long double T = 1 / wave->frequency;
 	long double delay = T * wave->phase / 360;
 	long double local_time = fmodl(t + delay, T);
@@ -89,99 +179,864 @@ static long double cosine_wave(const long double t, const struct WaveForm *wave)
 	return wave->amplitude * cosl(w) + wave->dc_offset;
 }
 
-static void wave_add(WaveGenerator *f, const long double t, const struct WaveForm *wave, long double *output)
+/* Evaluates a periodic wave over a block of times, replacing each time with its sample. The switch
+ * is taken once per block, so every loop calls one generator directly and the compiler can inline
+ * it rather than making an indirect call per sample. */
+static void generate_block(const struct WaveForm *wave, long double *times, const long count)
+{
+	switch (wave->type)
+	{
+		case SINE :
+			for (long i = 0; i < count; i++)
+			{
+				*(times + i) = sine_wave(*(times + i), wave);
+			}
+			break;
+		case COSINE :
+			for (long i = 0; i < count; i++)
+			{
+				*(times + i) = cosine_wave(*(times + i), wave);
+			}
+			break;
+		case SAWTOOTH :
+			for (long i = 0; i < count; i++)
+			{
+				*(times + i) = saw_wave(*(times + i), wave);
+			}
+			break;
+		case TRIANGLE :
+			for (long i = 0; i < count; i++)
+			{
+				*(times + i) = triangle_wave(*(times + i), wave);
+			}
+			break;
+		case SQUARE :
+			for (long i = 0; i < count; i++)
+			{
+				*(times + i) = square_wave(*(times + i), wave);
+			}
+			break;
+		default :	// Noise and sweeps are rendered by block in wave_generate()
+			break;
+	}
+}
+
+// Noise and sweeps have no fixed shape within a cycle.
+static int has_shape(const struct WaveForm *wave)
 {
-	*output += f(t, wave);
+	return wave->type == SINE || wave->type == COSINE || wave->type == SAWTOOTH || wave->type == TRIANGLE || wave->type == SQUARE;
 }
 
-static void wave_subtract(WaveGenerator *f, const long double t, const struct WaveForm *wave, long double *output)
+// Same shapes evaluated in place over a block of positions within the cycle [0, 1), used where phase is not linear in time.
+static void shape_block(const struct WaveForm *wave, long double *cycles, const long count)
 {
-	*output -= f(t, wave);
+	switch (wave->type)
+	{
+		case SINE :
+			for (long i = 0; i < count; i++)
+			{
+				*(cycles + i) = sine_shape(*(cycles + i), wave);
+			}
+			break;
+		case COSINE :
+			for (long i = 0; i < count; i++)
+			{
+				*(cycles + i) = cosine_shape(*(cycles + i), wave);
+			}
+			break;
+		case SAWTOOTH :
+			for (long i = 0; i < count; i++)
+			{
+				*(cycles + i) = saw_shape(*(cycles + i), wave);
+			}
+			break;
+		case TRIANGLE :
+			for (long i = 0; i < count; i++)
+			{
+				*(cycles + i) = triangle_shape(*(cycles + i), wave);
+			}
+			break;
+		case SQUARE :
+			for (long i = 0; i < count; i++)
+			{
+				*(cycles + i) = square_shape(*(cycles + i), wave);
+			}
+			break;
+		default :
+			break;
+	}
 }
 
-static void wave_AM(WaveGenerator *f, const long double t, const struct WaveForm *wave, long double *output)
+/* Swept sines from frequency to stop_frequency over sweep_samples. The phase at the start of the block
+ * is evaluated in closed form, then advanced by an increment that changes linearly (linear sweep)
+ * or geometrically (log sweep) from sample to sample. */
+static void chirp_wave(const struct WaveForm *wave, const long double T, const long start, const long count, long double *output)
 {
-	*output *= f(t, wave);
+	long double duration = wave->sweep_samples * T;
+	long double t = start * T;
+	long double f0 = wave->frequency;
+	long double f1 = wave->stop_frequency;
+	long double cycle, increment, growth;
+	int logarithmic = wave->type == LOG_CHIRP && f0 > 0 && f1 > 0 && f0 != f1;
+
+	if (logarithmic)
+	{
+		long double log_ratio = logl(f1 / f0);
+		long double scale = f0 * duration / log_ratio;
+		growth = expl(log_ratio * T / duration);
+		cycle = scale * (expl(log_ratio * t / duration) - 1.0L);
+		increment = scale * expl(log_ratio * t / duration) * (growth - 1.0L);
+	}
+	else
+	{
+		long double rate = duration > 0 ? (f1 - f0) / duration : 0.0L;
+		cycle = f0 * t + 0.5L * rate * t * t;
+		increment = f0 * T + rate * T * (t + 0.5L * T);
+		growth = rate * T * T;
+	}
+	cycle += wave->phase / 360.0L;
+	cycle -= floorl(cycle);
+
+	long double two_pi = 2.0L * acosl(-1);
+	for (long i = 0; i < count; i++)
+	{
+		*(output + i) = wave->amplitude * sinl(two_pi * cycle) + wave->dc_offset;
+		cycle += increment;
+		cycle -= floorl(cycle);
+		if (logarithmic)
+		{
+			increment *= growth;
+		}
+		else
+		{
+			increment += growth;
+		}
+	}
 }
 
-static void wave_divide(WaveGenerator *f, const long double t, const struct WaveForm *wave, long double *output)
+// Renders a single wave on its own into output.
+static void wave_generate(struct WaveForm *wave, const long double T, const long start, const long count, long double *output)
 {
-	*output /= f(t, wave);
+	switch (wave->type)
+	{
+		case WHITE_NOISE :
+			noise_white(wave->seed, start, count, output);
+			break;
+		case GAUSSIAN_NOISE :
+			noise_gaussian(wave->seed, start, count, output);
+			break;
+		case PINK_NOISE :
+			noise_pink(wave->seed, start, count, output);
+			break;
+		case BAND_NOISE :
+			noise_band_limited(wave->seed, wave->band_taps, start, count, output);
+			break;
+		case LINEAR_CHIRP :
+		case LOG_CHIRP :
+			chirp_wave(wave, T, start, count, output);
+			return;
+		default :
+			for (long i = 0; i < count; i++)
+			{
+				*(output + i) = (start + i) * T;
+			}
+			generate_block(wave, output, count);
+			return;
+	}
+
+	for (long i = 0; i < count; i++)
+	{
+		*(output + i) = wave->amplitude * *(output + i) + wave->dc_offset;
+	}
 }
 
-static void wave_FM(WaveGenerator *f, const long double t, const struct WaveForm *wave, long double *output)
+static void add_samples(const long double *samples, long double *output, const long count)
 {
-	struct WaveForm temp = *wave;
-	temp.frequency *= *output;
-	*output = f(t, &temp);
+	for (long i = 0; i < count; i++)
+	{
+		*(output + i) += *(samples + i);
+	}
 }
 
-int export_wave (struct WaveList *list)
+static void subtract_samples(const long double *samples, long double *output, const long count)
 {
-	if (list->first == NULL)
+	for (long i = 0; i < count; i++)
 	{
-		printf("Wave list is empty.");
-		return 0;
+		*(output + i) -= *(samples + i);
 	}
+}
 
-	FILE *fp;
-	fp = fopen("Test Data.csv", "w");	
-	if (fp != NULL)
+static void multiply_samples(const long double *samples, long double *output, const long count)
+{
+	for (long i = 0; i < count; i++)
+	{
+		*(output + i) *= *(samples + i);
+	}
+}
+
+static void divide_samples(const long double *samples, long double *output, const long count)
+{
+	for (long i = 0; i < count; i++)
+	{
+		*(output + i) /= *(samples + i);
+	}
+}
+
+// Renders the wave in chunks and combines each chunk into output.
+static void wave_apply(SampleOperation *operation, struct WaveForm *wave, const long double T, const long start, const long count, long double *output)
+{
+	long double samples[RENDER_CHUNK];
+
+	for (long i = 0; i < count; i += RENDER_CHUNK)
+	{
+		long length = count - i < RENDER_CHUNK ? count - i : RENDER_CHUNK;
+		wave_generate(wave, T, start + i, length, samples);
+		operation(samples, output + i, length);
+	}
+}
+
+static void wave_add(struct WaveForm *wave, const int slot, const long double T, const long start, const long count, long double *output)
+{
+	(void) slot;
+	wave_apply(&add_samples, wave, T, start, count, output);
+}
+
+static void wave_subtract(struct WaveForm *wave, const int slot, const long double T, const long start, const long count, long double *output)
+{
+	(void) slot;
+	wave_apply(&subtract_samples, wave, T, start, count, output);
+}
+
+static void wave_AM(struct WaveForm *wave, const int slot, const long double T, const long start, const long count, long double *output)
+{
+	(void) slot;
+	wave_apply(&multiply_samples, wave, T, start, count, output);
+}
+
+static void wave_divide(struct WaveForm *wave, const int slot, const long double T, const long start, const long count, long double *output)
+{
+	(void) slot;
+	wave_apply(&divide_samples, wave, T, start, count, output);
+}
+
+/* Instantaneous frequency is the wave frequency scaled by the signal below, integrated sample by
+ * sample into a running phase. Blocks are rendered in order, so the phase restarts at sample 0 and
+ * carries over between blocks. Each channel slot keeps its own phase. */
+static void wave_FM(struct WaveForm *wave, const int slot, const long double T, const long start, const long count, long double *output)
+{
+	if (!has_shape(wave))	// Noise and sweeps have no fixed frequency to modulate, so they are added
+	{
+		wave_add(wave, slot, T, start, count, output);
+		return;
+	}
+
+	if (start == 0)
+	{
+		wave->fm_phase[slot] = wave->phase / 360.0L;
+	}
+
+	long double increment = wave->frequency * T;
+	long double cycle = wave->fm_phase[slot];
+	for (long i = 0; i < count; i++)
+	{
+		long double next = cycle + increment * *(output + i);
+		*(output + i) = cycle;
+		cycle = next - floorl(next);
+	}
+	wave->fm_phase[slot] = cycle;
+	shape_block(wave, output, count);
+}
+
+// Signal below is added to the phase of the wave, in radians.
+static void wave_PM(struct WaveForm *wave, const int slot, const long double T, const long start, const long count, long double *output)
+{
+	(void) slot;
+
+	if (!has_shape(wave))
+	{
+		wave_add(wave, slot, T, start, count, output);
+		return;
+	}
+
+	long double increment = wave->frequency * T;
+	long double offset = wave->phase / 360.0L;
+	long double scale = 0.5L / acosl(-1);
+
+	for (long i = 0; i < count; i++)
+	{
+		long double cycle = increment * (start + i) + offset + scale * *(output + i);
+		*(output + i) = cycle - floorl(cycle);
+	}
+	shape_block(wave, output, count);
+}
+
+static WaveOperation *const combine[] = {
+	[ADD] = &wave_add,
+	[SUBTRACT] = &wave_subtract,
+	[AM] = &wave_AM,
+	[DIVIDE] = &wave_divide,
+	[FM] = &wave_FM,
+	[PM] = &wave_PM
+};
+
+static int in_channel(const struct WaveForm *wave, const int channel)
+{
+	return wave->channel == 0 || wave->channel == channel;
+}
+
+// Next wave below this one in the channel's chain, or NULL at the bottom.
+static struct WaveForm *next_in_channel(struct WaveForm *wave, const int channel)
+{
+	do
 	{
-		WaveGenerator *generate[5];
-		generate[SINE] = &sine_wave;
-		generate[COSINE] = &cosine_wave;
-		generate[SAWTOOTH] = &saw_wave;
-		generate[TRIANGLE] = &triangle_wave;
-		generate[SQUARE] = &square_wave;
+		wave = wave->next;
+	} while (wave != NULL && !in_channel(wave, channel));
 
-		WaveOperation *combine[6];
-		combine[ADD] = &wave_add;
-		combine[SUBTRACT] = &wave_subtract;
-		combine[AM] = &wave_AM;
-		combine[DIVIDE] = &wave_divide;
-		combine[FM] = &wave_FM;
+	return wave;
+}
+
+// Layers in the shared run at the bottom of the list are identical on every channel and use slot 0.
+static int channel_slot(const struct WaveForm *wave, const int channel)
+{
+	return wave->common ? 0 : channel - 1;
+}
+
+static int list_channels(const struct WaveList *list)
+{
+	if (list->channel_count < 1)
+	{
+		return 1;
+	}
+	return list->channel_count < WAVE_MAX_CHANNELS ? list->channel_count : WAVE_MAX_CHANNELS;
+}
 
-		long double T = 1.0 / list->sample_frequency;
-		struct WaveForm *selected_wave = list->first;
+// Marks the run of waves at the bottom of the list that belong to every channel.
+static void mark_common_waves(struct WaveForm *last_wave)
+{
+	int common = 1;
 
-		while (selected_wave->next != NULL)
+	for (struct WaveForm *wave = last_wave; wave != NULL; wave = wave->previous)
+	{
+		common = common && wave->channel == 0;
+		if (wave->common != common)
 		{
-			selected_wave = selected_wave->next;
-		}		
+			wave->common = common;
+			invalidate_wave_cache(wave);
+		}
+	}
+}
+
+/* Renders samples [start, start + count) of every channel, one channel per count samples of buffer.
+ * Waves combined from bottom of list up, the shared bottom run is rendered once and copied. */
+static void render_block(struct WaveForm *last_wave, const int channels, const long double T, const long start, const long count, long double *buffer)
+{
+	struct WaveForm *common_top = NULL;
+	struct WaveForm *wave = last_wave;
 
-		long double *buffer = malloc(list->sample_count * sizeof(long double));
-		for (int i = 0; i < list->sample_count; i++)
+	while (wave != NULL && wave->common)
+	{
+		if (common_top == NULL)
+		{
+			wave_generate(wave, T, start, count, buffer);
+		}
+		else
 		{
-			*(buffer + i) = generate[selected_wave->type](i * T, selected_wave); // WAVE_TYPE
+			combine[common_top->mode](wave, 0, T, start, count, buffer);
 		}
+		common_top = wave;
+		wave = wave->previous;
+	}
 
-		// Waves combined from bottom of list up.
-		selected_wave = selected_wave->previous;
-		while (selected_wave != NULL)
+	for (int channel = 2; channel <= channels && common_top != NULL; channel++)
+	{
+		memcpy(buffer + (channel - 1) * count, buffer, count * sizeof(long double));
+	}
+
+	for (int channel = 1; channel <= channels; channel++)
+	{
+		long double *output = buffer + (channel - 1) * count;
+		struct WaveForm *below = common_top;
+
+		for (struct WaveForm *selected_wave = wave; selected_wave != NULL; selected_wave = selected_wave->previous)
 		{
-			for (int i = 0; i < list->sample_count; i++)
+			if (!in_channel(selected_wave, channel))
+			{
+				continue;
+			}
+
+			if (below == NULL)
 			{
-				combine[selected_wave->next->mode](generate[selected_wave->type], i * T, selected_wave, buffer + i);
+				wave_generate(selected_wave, T, start, count, output);
 			}
-			selected_wave = selected_wave->previous;
+			else
+			{
+				combine[below->mode](selected_wave, channel - 1, T, start, count, output);
+			}
+			below = selected_wave;
 		}
 
-		fprintf(fp, "Time (s), Combined Signal\n");
-		for (int i = 0; i < list->sample_count; i++)
+		if (below == NULL)
 		{
-			fprintf(fp, "%Lf, %Lf\n", i * T, *(buffer + i));
+			memset(output, 0, count * sizeof(long double));
 		}
+	}
+}
 
-		free(buffer);
-		fclose(fp);
+// Partial result of a layer for one channel, within a cache of render_length samples per slot.
+static long double *cached_partial(const struct WaveForm *wave, const int channel, const long render_length)
+{
+	return wave->render_cache + channel_slot(wave, channel) * render_length;
+}
+
+// Renders samples [start, start + count) of the partial result at one layer and channel into its cache.
+static void render_layer_block(struct WaveForm *wave, const int channel, const long render_length, const long double T, const long start, const long count)
+{
+	long double *buffer = cached_partial(wave, channel, render_length) + start;
+	struct WaveForm *below = next_in_channel(wave, channel);
+
+	if (below == NULL)
+	{
+		wave_generate(wave, T, start, count, buffer);
+	}
+	else
+	{
+		memcpy(buffer, cached_partial(below, channel, render_length) + start, count * sizeof(long double));
+		combine[below->mode](wave, channel_slot(wave, channel), T, start, count, buffer);
+	}
+}
+
+// Re-renders a block of every cached layer from dirty_wave up to the top of the list.
+static void render_layers(struct WaveForm *dirty_wave, const int channels, const long render_length, const long double T, const long start, const long count)
+{
+	for (struct WaveForm *wave = dirty_wave; wave != NULL; wave = wave->previous)
+	{
+		for (int channel = 1; channel <= channels; channel++)
+		{
+			if (in_channel(wave, channel))
+			{
+				render_layer_block(wave, channel, render_length, T, start, count);
+				if (wave->common)
+				{
+					break;
+				}
+			}
+		}
+	}
+}
+
+static void free_render_cache(struct WaveList *list)
+{
+	for (struct WaveForm *wave = list->first; wave != NULL; wave = wave->next)
+	{
+		free(wave->render_cache);
+		wave->render_cache = NULL;
+		wave->render_valid = 0;
+	}
+	list->cache_length = 0;
+}
+
+/* Allocates layer caches, one slot per channel, for the current render length and finds the lowest
+ * layer needing a re-render. Returns 0 if the caches could not be allocated. */
+static int prepare_render_cache(struct WaveList *list, struct WaveForm *last_wave, const long render_length, struct WaveForm **dirty_wave)
+{
+	int channels = list_channels(list);
+
+	if (list->cache_length != render_length || list->cache_frequency != list->sample_frequency || list->cache_channels != channels)
+	{
+		free_render_cache(list);
+	}
+
+	for (struct WaveForm *wave = list->first; wave != NULL; wave = wave->next)
+	{
+		if (wave->render_cache == NULL)
+		{
+			wave->render_cache = malloc(channels * render_length * sizeof(long double));
+			wave->render_valid = 0;
+			if (wave->render_cache == NULL)
+			{
+				free_render_cache(list);
+				return 0;
+			}
+		}
+	}
+	list->cache_length = render_length;
+	list->cache_frequency = list->sample_frequency;
+	list->cache_channels = channels;
+
+	*dirty_wave = NULL;
+	for (struct WaveForm *wave = last_wave; wave != NULL && *dirty_wave == NULL; wave = wave->previous)
+	{
+		if (!wave->render_valid)
+		{
+			*dirty_wave = wave;
+		}
+	}
+
+	return 1;
+}
+
+// Top of the chain for a channel, NULL if no wave is routed to it.
+static struct WaveForm *channel_top(const struct WaveList *list, const int channel)
+{
+	struct WaveForm *wave = list->first;
+
+	while (wave != NULL && !in_channel(wave, channel))
+	{
+		wave = wave->next;
+	}
+	return wave;
+}
+
+// Interleaves one block of planar channel data into frames. Missing channels are silent.
+static void interleave(const long double *const *sources, const int channels, const long count, long double *frames)
+{
+	for (int channel = 0; channel < channels; channel++)
+	{
+		const long double *source = sources[channel];
+		for (long i = 0; i < count; i++)
+		{
+			*(frames + i * channels + channel) = source != NULL ? *(source + i) : 0.0L;
+		}
+	}
+}
+
+// Period of a single wave in whole samples, or 0 if fs / f is not a small rational.
+static long wave_period_samples(const double sample_frequency, const double frequency)
+{
+	if (frequency == 0.0)
+	{
 		return 1;
 	}
+
+	// Continued fraction expansion of fs / f, stopping at the first convergent within tolerance.
+	long double x = sample_frequency / fabsl(frequency);
+	long double remainder = x;
+	long h = 1, h_prev = 0;
+	long k = 0, k_prev = 1;
+
+	while (k <= PERIOD_MAX_DENOMINATOR)
+	{
+		long a = (long) floorl(remainder);
+		long h_next = a * h + h_prev;
+		long k_next = a * k + k_prev;
+		h_prev = h;
+		k_prev = k;
+		h = h_next;
+		k = k_next;
+
+		if (h > PERIOD_MAX_SAMPLES)
+		{
+			return 0;
+		}
+		if (fabsl(x - (long double) h / k) <= PERIOD_TOLERANCE * x)
+		{
+			return h;
+		}
+		if (remainder - a == 0.0L)
+		{
+			return 0;
+		}
+		remainder = 1.0L / (remainder - a);
+	}
+
+	return 0;
+}
+
+static long gcd(long a, long b)
+{
+	while (b != 0)
+	{
+		long temp = a % b;
+		a = b;
+		b = temp;
+	}
+	return a;
+}
+
+// Common period of all layers in samples (LCM of wave periods), or 0 if the list is not periodic.
+static long list_period_samples(const struct WaveList *list)
+{
+	long period = 1;
+
+	for (const struct WaveForm *wave = list->first; wave != NULL; wave = wave->next)
+	{
+		// FM output depends on absolute time, so the combination is not periodic.
+		if (wave != list->first && wave->mode == FM)
+		{
+			return 0;
+		}
+		// Noise and sweeps never repeat.
+		if (wave->type >= WHITE_NOISE)
+		{
+			return 0;
+		}
+
+		long wave_period = wave_period_samples(list->sample_frequency, wave->frequency);
+		if (wave_period == 0)
+		{
+			return 0;
+		}
+
+		period = period / gcd(period, wave_period) * wave_period;
+		if (period > PERIOD_MAX_SAMPLES)
+		{
+			return 0;
+		}
+	}
+
+	return period;
+}
+
+// Fills samples [start, start + count) by repeating one rendered period.
+static void tile_block(const long double *tile, const long period, const int start, const int count, long double *buffer)
+{
+	long offset = start % period;
+	int i = 0;
+
+	while (i < count)
+	{
+		long length = period - offset < count - i ? period - offset : count - i;
+		memcpy(buffer + i, tile + offset, length * sizeof(long double));
+		i += length;
+		offset = 0;
+	}
+}
+
+/* Picks the band limited table for each wave at the current sample rate, or analytic rendering.
+ * Band limited noise filters are designed here too, only when their cutoff has changed. */
+static void select_wavetables(struct WaveList *list)
+{
+	for (struct WaveForm *wave = list->first; wave != NULL; wave = wave->next)
+	{
+		const double *table = NULL;
+		double max_harmonic = list->sample_frequency / (2.0 * fabs(wave->frequency));
+		double cutoff = wave->frequency / list->sample_frequency;
+
+		if (wave->type == BAND_NOISE && cutoff != wave->band_cutoff)
+		{
+			noise_band_taps(cutoff, wave->band_taps);
+			wave->band_cutoff = cutoff;
+		}
+
+		if (list->wavetable && (wave->type == SAWTOOTH || wave->type == SQUARE))
+		{
+			table = wavetable_ramp(max_harmonic);
+		}
+		else if (list->wavetable && wave->type == TRIANGLE)
+		{
+			table = wavetable_triangle(max_harmonic);
+		}
+
+		if (table != wave->wavetable)
+		{
+			wave->wavetable = table;
+			invalidate_wave_cache(wave);
+		}
+	}
+}
+
+// Writes the CSV column headings for a CSV export. Q format exports tag each column with it.
+static void write_csv_header(FILE *fp, const int channels, const int fraction_bits)
+{
+	char tag[16] = "";
+
+	if (fraction_bits > 0)
+	{
+		sprintf(tag, " (Q%d)", fraction_bits);
+	}
+	if (channels == 1)
+	{
+		fprintf(fp, "Time (s), Combined Signal%s\n", tag);
+	}
 	else
+	{
+		fprintf(fp, "Time (s)");
+		for (int channel = 1; channel <= channels; channel++)
+		{
+			fprintf(fp, ", Channel %d%s", channel, tag);
+		}
+		fprintf(fp, "\n");
+	}
+}
+
+int export_wave (struct WaveList *list)
+{
+	if (list->first == NULL)
+	{
+		printf("Wave list is empty.");
+		return 0;
+	}
+
+	long double T = 1.0 / list->sample_frequency;
+	int channels = list_channels(list);
+	struct WaveForm *last_wave = list->first;
+
+	while (last_wave->next != NULL)
+	{
+		last_wave = last_wave->next;
+	}
+
+	/* CSV is formatted, and for Q formats quantised, by the writer thread while this thread
+	 * renders. WAV samples are quantised straight into a mapping of the output file. */
+	FILE *fp = NULL;
+	struct ExportWriter *writer = NULL;
+	struct WavFile *wav = NULL;
+	int fraction_bits = list->export_format == CSV_Q15 ? 15 : list->export_format == CSV_Q31 ? 31 : 0;
+	if (list->export_format == CSV_EXPORT || fraction_bits > 0)
+	{
+		fp = fopen("Test Data.csv", "w");
+		writer = fp != NULL ? export_writer_start(fp, T, channels, fraction_bits, list->dither) : NULL;
+	}
+	else
+	{
+		static const enum WavSampleFormat wav_formats[] = { [WAV_PCM16] = WAV_INT16, [WAV_PCM24] = WAV_INT24, [WAV_FLOAT] = WAV_FLOAT32 };
+		wav = wav_open("Test Data.wav", channels, list->sample_frequency, list->sample_count, wav_formats[list->export_format], list->dither);
+	}
+
+	long double *planar = malloc(channels * EXPORT_BLOCK_SIZE * sizeof(long double));
+	if ((writer == NULL && wav == NULL) || planar == NULL)
 	{
 		printf("Could not open file for editing.\n");
+		if (writer != NULL)
+		{
+			export_writer_finish(writer);
+		}
+		if (fp != NULL)
+		{
+			fclose(fp);
+		}
+		if (wav != NULL)
+		{
+			wav_close(wav);
+		}
+		free(planar);
 		return 0;
 	}
+
+	select_wavetables(list);
+	mark_common_waves(last_wave);
+	for (struct WaveForm *wave = list->first; wave != NULL; wave = wave->next)
+	{
+		wave->sweep_samples = list->sample_count;
+	}
+
+	// Periodic lists only need one period rendered, the rest of the export is copied.
+	long period = list->tile_periodic ? list_period_samples(list) : 0;
+	int tiled = period > 0 && period < list->sample_count;
+	long render_length = tiled ? period : list->sample_count;
+
+	// Cached layers below the lowest edited wave are reused, only layers above it are re-rendered.
+	struct WaveForm *dirty_wave = NULL;
+	int cached = list->cache_layers && prepare_render_cache(list, last_wave, render_length, &dirty_wave);
+
+	// Output of each channel, either a cached top layer or a rendered period.
+	const long double *channel_output[WAVE_MAX_CHANNELS];
+	for (int channel = 1; channel <= channels; channel++)
+	{
+		struct WaveForm *top = channel_top(list, channel);
+		channel_output[channel - 1] = cached && top != NULL ? cached_partial(top, channel, render_length) : NULL;
+	}
+
+	long double *tile_buffer = NULL;
+	if (tiled && cached)
+	{
+		render_layers(dirty_wave, channels, render_length, T, 0, period);
+		dirty_wave = NULL;
+	}
+	else if (tiled)
+	{
+		tile_buffer = malloc(channels * period * sizeof(long double));
+		if (tile_buffer != NULL)
+		{
+			render_block(last_wave, channels, T, 0, period, tile_buffer);
+			for (int channel = 0; channel < channels; channel++)
+			{
+				channel_output[channel] = tile_buffer + channel * period;
+			}
+		}
+		else
+		{
+			tiled = 0;
+		}
+	}
+
+	if (fp != NULL)
+	{
+		write_csv_header(fp, channels, fraction_bits);
+	}
+
+	for (int start = 0; start < list->sample_count; start += EXPORT_BLOCK_SIZE)
+	{
+		const long double *sources[WAVE_MAX_CHANNELS];
+		int count = list->sample_count - start < EXPORT_BLOCK_SIZE ? list->sample_count - start : EXPORT_BLOCK_SIZE;
+
+		for (int channel = 0; channel < channels; channel++)
+		{
+			long double *scratch = planar + channel * count;
+
+			if (tiled && channel_output[channel] != NULL)
+			{
+				tile_block(channel_output[channel], period, start, count, scratch);
+				sources[channel] = scratch;
+			}
+			else if (tiled || cached)
+			{
+				sources[channel] = channel_output[channel] != NULL ? channel_output[channel] + start : NULL;
+			}
+			else
+			{
+				sources[channel] = scratch;
+			}
+		}
+
+		if (cached && !tiled)
+		{
+			render_layers(dirty_wave, channels, render_length, T, start, count);
+		}
+		else if (!cached && !tiled)
+		{
+			render_block(last_wave, channels, T, start, count, planar);
+		}
+
+		if (wav != NULL)
+		{
+			wav_store(wav, start, sources, count);
+		}
+		else
+		{
+			struct ExportBlock *block = export_writer_acquire(writer);
+			block->start = start;
+			block->count = count;
+			interleave(sources, channels, count, block->samples);
+			export_writer_commit(writer);
+		}
+	}
+
+	if (cached)
+	{
+		for (struct WaveForm *wave = list->first; wave != NULL; wave = wave->next)
+		{
+			wave->render_valid = 1;
+		}
+	}
+	free(tile_buffer);
+	free(planar);
+
+	if (wav != NULL)
+	{
+		return wav_close(wav);
+	}
+	export_writer_finish(writer);
+	fclose(fp);
+	return 1;
+}
+
+void invalidate_wave_cache(struct WaveForm *wave)
+{
+	if (wave != NULL)
+	{
+		wave->render_valid = 0;
+	}
 }
 
 void add_wave(struct WaveList *list)
@@ -196,8 +1051,16 @@ void add_wave(struct WaveList *list)
 	new_wave->duty = 0.0;
 	new_wave->mode = ADD;
 	new_wave->dc_offset = 0.0;
+	new_wave->stop_frequency = 10000.0;
+	new_wave->sweep_samples = 0;
 	new_wave->next = NULL;
 	new_wave->previous = NULL;
+	new_wave->render_cache = NULL;
+	new_wave->render_valid = 0;
+	new_wave->channel = 0;
+	new_wave->wavetable = NULL;
+	new_wave->band_cutoff = -1.0;
+	new_wave->seed = list->next_seed++;
 
 	if (list->first == NULL)
 	{
@@ -230,6 +1093,7 @@ void delete_wave(struct WaveList *list)
         if (previous_wave != NULL)
 		{
 			previous_wave->next = old_wave->next;
+			invalidate_wave_cache(previous_wave);
 			list->selected = previous_wave;
 		}
 		else
@@ -246,6 +1110,7 @@ void delete_wave(struct WaveList *list)
 			list->first = NULL;
 			list->selected = NULL;
 		}
+		free(old_wave->render_cache);
 		free(old_wave);
 	}
 }
@@ -256,6 +1121,9 @@ void move_selected_wave_up (struct WaveList *list)
 	
 	if (target != NULL && target->previous != NULL)
 	{
+		invalidate_wave_cache(target);
+		invalidate_wave_cache(target->previous);
+
 		struct WaveForm *b = target->previous;
 		struct WaveForm *c = target->next;
 		
@@ -293,6 +1161,9 @@ void move_selected_wave_down (struct WaveList *list)
 
 	if (target != NULL && target->next != NULL)
 	{
+		invalidate_wave_cache(target);
+		invalidate_wave_cache(target->next);
+
 		struct WaveForm *a = target->previous;
 		struct WaveForm *b = target->next;
 
@@ -15,11 +15,19 @@
  *
  ************************************************************************************************ */
 
-#define WAVETYPE_MENU { "Sine    ", "Cosine  ", "Sawtooth", "Triangle", "Square  " }
-#define WAVEMODE_MENU { "Add     ", "Subtract", "AM      ", "Divide  ",  "FM      " }
+#include "noise.h"
 
-enum WaveType { SINE, COSINE, SAWTOOTH, TRIANGLE, SQUARE };
-enum WaveMode { ADD, SUBTRACT, AM, DIVIDE, FM };
+#define WAVETYPE_MENU { "Sine    ", "Cosine  ", "Sawtooth", "Triangle", "Square  ", "White   ", "Gaussian", "Pink    ", "Band Lim", "Lin Chrp", "Log Chrp" }
+#define WAVEMODE_MENU { "Add     ", "Subtract", "AM      ", "Divide  ",  "FM      ", "PM      " }
+
+#define WAVE_MAX_CHANNELS 32
+
+enum WaveType { SINE, COSINE, SAWTOOTH, TRIANGLE, SQUARE, WHITE_NOISE, GAUSSIAN_NOISE, PINK_NOISE, BAND_NOISE, LINEAR_CHIRP, LOG_CHIRP };
+enum WaveMode { ADD, SUBTRACT, AM, DIVIDE, FM, PM };
+
+#define EXPORT_FORMAT_MENU { "CSV       ", "WAV PCM16 ", "WAV PCM24 ", "WAV Float ", "CSV Q15   ", "CSV Q31   " }
+
+enum ExportFormat { CSV_EXPORT, WAV_PCM16, WAV_PCM24, WAV_FLOAT, CSV_Q15, CSV_Q31 };
 
 struct WaveForm {
     enum WaveType type;
@@ -29,6 +37,17 @@ struct WaveForm {
     double duty;
     enum WaveMode mode;
     double dc_offset;
+    double stop_frequency;	// Sweep end, frequency is the sweep start
+    long sweep_samples;		// Sweep length, set to the export length
+    long double *render_cache;	// Partial result of this wave combined with all waves below it
+    int render_valid;
+    int channel;		// Output channel from 1, or 0 for every channel
+    int common;			// Part of the shared run at the bottom of the list, rendered once for all channels
+    long double fm_phase[WAVE_MAX_CHANNELS];	// Running FM phase in cycles per channel, carried between blocks
+    unsigned long seed;		// Noise stream, reproducible regardless of render order
+    const double *wavetable;	// Band limited table at the current sample rate, NULL renders analytically
+    double band_cutoff;		// Cycles per sample band_taps were designed for, negative before the first design
+    double band_taps[NOISE_BAND_TAPS];	// Lowpass for band limited noise at the current sample rate
     struct WaveForm *previous;
     struct WaveForm *next;
 };
@@ -37,6 +56,16 @@ struct WaveList {
     char *export_path;
     int sample_count;
     double sample_frequency;
+    int channel_count;
+    enum ExportFormat export_format;
+    int dither;			// TPDF dither when quantising to integer WAV or Q formats
+    int tile_periodic;		// Render one common period and repeat it when possible
+    int cache_layers;		// Keep per layer partial results between exports
+    int wavetable;		// Band limited wavetables for sawtooth, triangle and square
+    unsigned long next_seed;	// Seed given to the next added wave
+    long cache_length;
+    double cache_frequency;
+    int cache_channels;
     struct WaveForm *first;
     struct WaveForm *selected;
 };
@@ -44,6 +73,7 @@ struct WaveList {
 void add_wave (struct WaveList *list);
 void delete_wave (struct WaveList *list);
 int export_wave (struct WaveList *list);
+void invalidate_wave_cache (struct WaveForm *wave);
 void move_selected_wave_up (struct WaveList *list);
 void move_selected_wave_down (struct WaveList *list); 
 
@@ -0,0 +1,94 @@
+/************************************************************************************************
+ * FilterTools/wavetable.c
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Band limited wavetables, one per octave of harmonic content, for the
+ * 		  non-sinusoidal wave shapes.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#include "wavetable.h"
+
+#include <math.h>
+#include <pthread.h>
+
+// One guard point per table so interpolation never wraps.
+static double ramp_tables[WAVETABLE_OCTAVES][WAVETABLE_SIZE + 1];
+static double triangle_tables[WAVETABLE_OCTAVES][WAVETABLE_SIZE + 1];
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
+
+/* Tables are built by adding the next octave of harmonics to the previous table.
+ * Ramp: band limited (frac(x) - 0.5), Fourier series -1/pi * sum(sin(2 pi k x) / k).
+ * Triangle: unit peak, 8/pi^2 * sum over odd k of (-1)^((k - 1) / 2) * sin(2 pi k x) / k^2. */
+static void build_tables(void)
+{
+	int first_harmonic = 1;
+
+	for (int octave = 0; octave < WAVETABLE_OCTAVES; octave++)
+	{
+		int last_harmonic = 1 << octave;
+
+		for (int i = 0; i < WAVETABLE_SIZE; i++)
+		{
+			double ramp = octave > 0 ? ramp_tables[octave - 1][i] : 0.0;
+			double triangle = octave > 0 ? triangle_tables[octave - 1][i] : 0.0;
+			double x = 2.0 * M_PI * i / WAVETABLE_SIZE;
+
+			for (int k = first_harmonic; k <= last_harmonic; k++)
+			{
+				double s = sin(k * x);
+				ramp -= s / (M_PI * k);
+				if (k % 2 == 1)
+				{
+					triangle += (k % 4 == 1 ? 8.0 : -8.0) * s / (M_PI * M_PI * k * k);
+				}
+			}
+			ramp_tables[octave][i] = ramp;
+			triangle_tables[octave][i] = triangle;
+		}
+		ramp_tables[octave][WAVETABLE_SIZE] = ramp_tables[octave][0];
+		triangle_tables[octave][WAVETABLE_SIZE] = triangle_tables[octave][0];
+
+		first_harmonic = last_harmonic + 1;
+	}
+}
+
+// Largest table whose top harmonic does not exceed max_harmonic.
+static int select_octave(double max_harmonic)
+{
+	if (max_harmonic >= 1 << (WAVETABLE_OCTAVES - 1))
+	{
+		return WAVETABLE_OCTAVES - 1;
+	}
+
+	return max_harmonic >= 1.0 ? (int) floor(log2(max_harmonic)) : 0;
+}
+
+const double *wavetable_ramp(double max_harmonic)
+{
+	pthread_once(&tables_once, &build_tables);
+	return ramp_tables[select_octave(max_harmonic)];
+}
+
+const double *wavetable_triangle(double max_harmonic)
+{
+	pthread_once(&tables_once, &build_tables);
+	return triangle_tables[select_octave(max_harmonic)];
+}
+
+// Linear interpolation at a position within the cycle [0, 1).
+long double wavetable_read(const double *table, long double cycle)
+{
+	long double position = cycle * WAVETABLE_SIZE;
+	long index = (long) position;
+	long double fraction = position - index;
+
+	index &= WAVETABLE_SIZE - 1;
+	return table[index] + fraction * (table[index + 1] - table[index]);
+}
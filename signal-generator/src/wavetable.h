@@ -0,0 +1,26 @@
+#ifndef WAVETABLE
+#define WAVETABLE
+
+/************************************************************************************************
+ * FilterTools/wavetable.h
+ *
+ * Author	: Ben Passman
+ * Created	: 19/10/2026
+ *
+ * Description	: Band limited wavetables, one per octave of harmonic content, for the
+ * 		  non-sinusoidal wave shapes.
+ *
+ * Revision History:
+ * Date         Author      Rev     Notes
+ * 19/10/2026   Ben P       1.0     File created
+ *
+ ************************************************************************************************ */
+
+#define WAVETABLE_SIZE 4096	// Must be a power of 2
+#define WAVETABLE_OCTAVES 11	// Tables hold up to 1, 2, 4 ... 1024 harmonics
+
+const double *wavetable_ramp(double max_harmonic);
+const double *wavetable_triangle(double max_harmonic);
+long double wavetable_read(const double *table, long double cycle);
+
+#endif